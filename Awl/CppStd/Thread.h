@@ -3,6 +3,7 @@
 #include <thread>
 #include <condition_variable>
 #include <stop_token>
+#include <algorithm>
 
 //defined(__APPLE__) || defined(__ANDROID__)
 #ifdef AWL_JTHREAD_EXTRAS
@@ -23,3 +24,12 @@
     }
 
 #endif
+
+namespace awl
+{
+    //The number of the worker threads used by the parallel algorithms by default.
+    inline size_t DefaultThreadCount()
+    {
+        return std::max(std::thread::hardware_concurrency(), 1u);
+    }
+}
@@ -49,6 +49,23 @@
 #include <stdint.h>
 #include <array>
 #include <type_traits>
+#include <iterator>
+#include <memory>
+#include <cstring>
+#include <bit>
+
+//The carry-less multiplication kernel is compiled for x86-64 with the function level target attribute,
+//so the rest of the code does not require any instruction set flags. It is used if the CPU supports it.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #define AWL_CRC64_CLMUL
+    #define AWL_CRC64_CLMUL_TARGET __attribute__((target("pclmul,sse2")))
+    #include <immintrin.h>
+#elif defined(_M_X64) && defined(_MSC_VER)
+    #define AWL_CRC64_CLMUL
+    #define AWL_CRC64_CLMUL_TARGET
+    #include <intrin.h>
+    #include <immintrin.h>
+#endif
 
 namespace awl::crypto
 {
@@ -64,6 +81,17 @@ namespace awl::crypto
         {
             using T = typename std::iterator_traits<InputIt>::value_type;
 
+            //The bytes of a contiguous range are the same as the bytes of its elements.
+            if constexpr (std::contiguous_iterator<InputIt>)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    const auto size = static_cast<size_t>(end - begin) * sizeof(T);
+
+                    return to_buffer(Update(m_seed, reinterpret_cast<const uint8_t*>(std::to_address(begin)), size));
+                }
+            }
+
             uint64_t crc = m_seed;
 
             for (InputIt i = begin; i != end; ++i)
@@ -226,5 +254,297 @@ namespace awl::crypto
         {
             crc = crc64_tab[static_cast<uint8_t>(crc) ^ byte] ^ (crc >> 8);
         }
+
+        //sliceTables[k][i] is the CRC of byte i followed by k zero bytes.
+        using SliceTables = std::array<std::array<uint64_t, 256>, 16>;
+
+        static constexpr SliceTables MakeSliceTables()
+        {
+            SliceTables tables{};
+
+            for (size_t i = 0; i < 256; ++i)
+            {
+                tables[0][i] = crc64_tab[i];
+            }
+
+            for (size_t k = 1; k < tables.size(); ++k)
+            {
+                for (size_t i = 0; i < 256; ++i)
+                {
+                    const uint64_t prev = tables[k - 1][i];
+
+                    tables[k][i] = crc64_tab[static_cast<uint8_t>(prev)] ^ (prev >> 8);
+                }
+            }
+
+            return tables;
+        }
+
+        //Defined after the class, because it is computed by a member function.
+        static const SliceTables sliceTables;
+
+        static uint64_t LoadLe64(const uint8_t* p)
+        {
+            uint64_t val;
+
+            std::memcpy(&val, p, sizeof(val));
+
+            if constexpr (std::endian::native == std::endian::big)
+            {
+                val = std::byteswap(val);
+            }
+
+            return val;
+        }
+
+        static uint64_t Slice8(uint64_t a, size_t k)
+        {
+            return sliceTables[k + 7][static_cast<uint8_t>(a)] ^
+                sliceTables[k + 6][static_cast<uint8_t>(a >> 8)] ^
+                sliceTables[k + 5][static_cast<uint8_t>(a >> 16)] ^
+                sliceTables[k + 4][static_cast<uint8_t>(a >> 24)] ^
+                sliceTables[k + 3][static_cast<uint8_t>(a >> 32)] ^
+                sliceTables[k + 2][static_cast<uint8_t>(a >> 40)] ^
+                sliceTables[k + 1][static_cast<uint8_t>(a >> 48)] ^
+                sliceTables[k][a >> 56];
+        }
+
+        //The reflected polynomial, the most significant bit is x^0.
+        static constexpr uint64_t reflectedPoly = UINT64_C(0x95ac9329ac4bc9b5);
+
+        //a * b mod P of bit-reflected polynomials.
+        static constexpr uint64_t MultiplyMod(uint64_t a, uint64_t b)
+        {
+            uint64_t product = 0;
+
+            for (uint64_t m = UINT64_C(1) << 63; m != 0; m >>= 1)
+            {
+                if ((a & m) != 0)
+                {
+                    product ^= b;
+                }
+
+                b = (b & 1) != 0 ? (b >> 1) ^ reflectedPoly : b >> 1;
+            }
+
+            return product;
+        }
+
+        using PowerTable = std::array<uint64_t, 64>;
+
+        //powerTable[i] is x^(2^i) mod P.
+        static constexpr PowerTable MakePowerTable()
+        {
+            PowerTable table{};
+
+            //x^1
+            table[0] = UINT64_C(1) << 62;
+
+            for (size_t i = 1; i < table.size(); ++i)
+            {
+                table[i] = MultiplyMod(table[i - 1], table[i - 1]);
+            }
+
+            return table;
+        }
+
+        static const PowerTable powerTable;
+
+        //x^n mod P, bit-reflected. A fold over d bits multiplies the high-degree half of a block by x^(d + 63) mod P
+        //and the low-degree half by x^(d - 1) mod P, because the product of the reflected values is shifted by one bit.
+        static constexpr uint64_t FoldConstant(size_t n)
+        {
+            //The polynomial without the x^64 term in the normal bit order.
+            constexpr uint64_t poly = UINT64_C(0xad93d23594c935a9);
+
+            uint64_t r = 1;
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                r = (r << 1) ^ ((r >> 63) != 0 ? poly : 0);
+            }
+
+            uint64_t reflected = 0;
+
+            for (size_t i = 0; i < 64; ++i)
+            {
+                reflected |= ((r >> i) & 1) << (63 - i);
+            }
+
+            return reflected;
+        }
+
+    public:
+
+        //The kernels below continue the CRC of the preceding data with the next size bytes.
+        //They produce the same value and can be called directly for testing and benchmarking.
+
+        static uint64_t UpdateBytes(uint64_t crc, const uint8_t* p, size_t size)
+        {
+            for (const uint8_t* end = p + size; p != end; ++p)
+            {
+                Calc(crc, *p);
+            }
+
+            return crc;
+        }
+
+        static uint64_t UpdateSlicing8(uint64_t crc, const uint8_t* p, size_t size)
+        {
+            for (; size >= 8; p += 8, size -= 8)
+            {
+                crc = Slice8(crc ^ LoadLe64(p), 0);
+            }
+
+            return UpdateBytes(crc, p, size);
+        }
+
+        static uint64_t UpdateSlicing16(uint64_t crc, const uint8_t* p, size_t size)
+        {
+            for (; size >= 16; p += 16, size -= 16)
+            {
+                crc = Slice8(crc ^ LoadLe64(p), 8) ^ Slice8(LoadLe64(p + 8), 0);
+            }
+
+            return UpdateSlicing8(crc, p, size);
+        }
+
+#ifdef AWL_CRC64_CLMUL
+
+        static bool HasClmul()
+        {
+            static const bool supported = DetectClmul();
+
+            return supported;
+        }
+
+        //Folds 16 byte blocks with the carry-less multiplication by x^n mod P, so the CRC of the message does not change,
+        //and computes the CRC of the last block with the tables. Four independent lanes hide the multiplication latency.
+        AWL_CRC64_CLMUL_TARGET static uint64_t UpdateClmul(uint64_t crc, const uint8_t* p, size_t size)
+        {
+            if (size < 32)
+            {
+                return UpdateSlicing16(crc, p, size);
+            }
+
+            constexpr uint64_t k1_low = FoldConstant(191);
+            constexpr uint64_t k1_high = FoldConstant(127);
+            constexpr uint64_t k4_low = FoldConstant(575);
+            constexpr uint64_t k4_high = FoldConstant(511);
+
+            const __m128i k1 = _mm_set_epi64x(static_cast<int64_t>(k1_high), static_cast<int64_t>(k1_low));
+
+            //The CRC register is the XOR with the first 8 bytes of the message.
+            __m128i x = _mm_xor_si128(Load128(p), _mm_set_epi64x(0, static_cast<int64_t>(crc)));
+
+            p += 16;
+            size -= 16;
+
+            if (size >= 112)
+            {
+                const __m128i k4 = _mm_set_epi64x(static_cast<int64_t>(k4_high), static_cast<int64_t>(k4_low));
+
+                __m128i x1 = Load128(p);
+                __m128i x2 = Load128(p + 16);
+                __m128i x3 = Load128(p + 32);
+
+                p += 48;
+                size -= 48;
+
+                for (; size >= 64; p += 64, size -= 64)
+                {
+                    x = _mm_xor_si128(Fold(x, k4), Load128(p));
+                    x1 = _mm_xor_si128(Fold(x1, k4), Load128(p + 16));
+                    x2 = _mm_xor_si128(Fold(x2, k4), Load128(p + 32));
+                    x3 = _mm_xor_si128(Fold(x3, k4), Load128(p + 48));
+                }
+
+                x = _mm_xor_si128(Fold(x, k1), x1);
+                x = _mm_xor_si128(Fold(x, k1), x2);
+                x = _mm_xor_si128(Fold(x, k1), x3);
+            }
+
+            for (; size >= 16; p += 16, size -= 16)
+            {
+                x = _mm_xor_si128(Fold(x, k1), Load128(p));
+            }
+
+            uint8_t last[16];
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(last), x);
+
+            return UpdateSlicing16(UpdateSlicing16(0, last, sizeof(last)), p, size);
+        }
+
+#endif
+
+        //Multiplies the CRC by x^(8 * size) mod P, that is the CRC of the same data followed by size zero bytes
+        //when the CRC starts with zero.
+        static uint64_t Shift(uint64_t crc, uint64_t size)
+        {
+            //x^(8 * size) is the product of x^(2^(i + 3)) for every bit i set in size.
+            for (size_t i = 0; size != 0; size >>= 1, ++i)
+            {
+                if ((size & 1) != 0)
+                {
+                    crc = MultiplyMod(crc, powerTable[i + 3]);
+                }
+            }
+
+            return crc;
+        }
+
+        //The CRC of A followed by B, where crc_b is calculated over size_b bytes of B starting with zero,
+        //so the parts can be calculated independently.
+        static uint64_t Combine(uint64_t crc_a, uint64_t crc_b, uint64_t size_b)
+        {
+            return Shift(crc_a, size_b) ^ crc_b;
+        }
+
+        //The fastest kernel the CPU supports.
+        static uint64_t Update(uint64_t crc, const uint8_t* p, size_t size)
+        {
+#ifdef AWL_CRC64_CLMUL
+            if (HasClmul())
+            {
+                return UpdateClmul(crc, p, size);
+            }
+#endif
+            return UpdateSlicing16(crc, p, size);
+        }
+
+    private:
+
+#ifdef AWL_CRC64_CLMUL
+
+        static bool DetectClmul()
+        {
+#if defined(_MSC_VER)
+            int info[4];
+
+            __cpuid(info, 1);
+
+            return (info[2] & (1 << 1)) != 0;
+#else
+            return __builtin_cpu_supports("pclmul");
+#endif
+        }
+
+        AWL_CRC64_CLMUL_TARGET static __m128i Load128(const uint8_t* p)
+        {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        }
+
+        //The low half is multiplied by the low constant and the high half by the high constant.
+        AWL_CRC64_CLMUL_TARGET static __m128i Fold(__m128i x, __m128i k)
+        {
+            return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00), _mm_clmulepi64_si128(x, k, 0x11));
+        }
+
+#endif
     };
+
+    inline constexpr Crc64::SliceTables Crc64::sliceTables = Crc64::MakeSliceTables();
+
+    inline constexpr Crc64::PowerTable Crc64::powerTable = Crc64::MakePowerTable();
 }
@@ -0,0 +1,482 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Awl/Crypto/BasicHash.h"
+#include "Awl/Int2Array.h"
+
+#include <stdint.h>
+#include <array>
+#include <vector>
+#include <type_traits>
+#include <iterator>
+#include <memory>
+#include <cstring>
+#include <bit>
+
+//SSE2 is a part of x86-64, so the bulk kernel does not require any instruction set flags.
+#if defined(__x86_64__) || defined(_M_X64)
+    #define AWL_FAST_HASH_SSE2
+    #include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(__SIZEOF_INT128__)
+    #include <intrin.h>
+#endif
+
+namespace awl::crypto
+{
+    //A fast non-cryptographic hash for the integrity checks and hash tables. Short inputs are mixed with 64x64 to 128 bit
+    //multiplications, long inputs are split into 64 byte stripes accumulated in eight independent lanes with 32x32 to 64 bit
+    //multiplications, so the bulk loop is vectorized. The value is the same on all the platforms.
+    class FastHashFunctions
+    {
+    public:
+
+        //Multiplies a by b and folds the 128 bit product.
+        static uint64_t Mix(uint64_t a, uint64_t b)
+        {
+            Multiply(a, b);
+
+            return a ^ b;
+        }
+
+        static uint64_t Hash64(const uint8_t* p, size_t size, uint64_t seed)
+        {
+            if (size <= shortSize)
+            {
+                return HashShort(p, size, seed);
+            }
+
+            std::array<uint64_t, laneCount> acc = Accumulate<true>(p, size, seed);
+
+            return Merge(acc, size, mergeOffset);
+        }
+
+        //Two independent 64 bit values.
+        static std::array<uint64_t, 2> Hash128(const uint8_t* p, size_t size, uint64_t seed)
+        {
+            if (size <= shortSize)
+            {
+                return { HashShort(p, size, seed), HashShort(p, size, seed ^ secret[highSeedIndex]) };
+            }
+
+            std::array<uint64_t, laneCount> acc = Accumulate<true>(p, size, seed);
+
+            return { Merge(acc, size, mergeOffset), Merge(acc, size, highMergeOffset) };
+        }
+
+        //The same value without the vector instructions, for testing and benchmarking.
+        static uint64_t Hash64Scalar(const uint8_t* p, size_t size, uint64_t seed)
+        {
+            if (size <= shortSize)
+            {
+                return HashShort(p, size, seed);
+            }
+
+            std::array<uint64_t, laneCount> acc = Accumulate<false>(p, size, seed);
+
+            return Merge(acc, size, mergeOffset);
+        }
+
+    private:
+
+        static constexpr size_t shortSize = 128;
+
+        static constexpr size_t laneCount = 8;
+
+        static constexpr size_t stripeSize = laneCount * sizeof(uint64_t);
+
+        //The accumulators are scrambled after each block of stripes.
+        static constexpr size_t blockStripeCount = 16;
+
+        //Each stripe of a block uses the keys shifted by one, the last partial stripe uses the next offset.
+        static constexpr size_t stripeKeyCount = blockStripeCount + laneCount;
+
+        static constexpr size_t scrambleOffset = stripeKeyCount;
+
+        static constexpr size_t initOffset = scrambleOffset + laneCount;
+
+        static constexpr size_t mergeOffset = initOffset + laneCount;
+
+        static constexpr size_t highMergeOffset = mergeOffset + laneCount;
+
+        static constexpr size_t highSeedIndex = highMergeOffset + laneCount;
+
+        static constexpr size_t secretSize = highSeedIndex + 1;
+
+        static constexpr uint64_t prime32 = UINT64_C(0x9E3779B1);
+
+        using Secret = std::array<uint64_t, secretSize>;
+
+        //SplitMix64 sequence.
+        static constexpr Secret MakeSecret()
+        {
+            Secret secret{};
+
+            uint64_t x = 0;
+
+            for (uint64_t& val : secret)
+            {
+                x += UINT64_C(0x9e3779b97f4a7c15);
+
+                uint64_t z = x;
+
+                z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+                z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+
+                val = z ^ (z >> 31);
+            }
+
+            return secret;
+        }
+
+        //Defined after the class, because it is computed by a member function.
+        static const Secret secret;
+
+        static void Multiply(uint64_t& a, uint64_t& b)
+        {
+#if defined(__SIZEOF_INT128__)
+            const __uint128_t product = static_cast<__uint128_t>(a) * b;
+
+            a = static_cast<uint64_t>(product);
+            b = static_cast<uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+            a = _umul128(a, b, &b);
+#else
+            const uint64_t a_high = a >> 32;
+            const uint64_t a_low = static_cast<uint32_t>(a);
+            const uint64_t b_high = b >> 32;
+            const uint64_t b_low = static_cast<uint32_t>(b);
+
+            const uint64_t low_low = a_low * b_low;
+            const uint64_t high_low = a_high * b_low;
+            const uint64_t low_high = a_low * b_high;
+            const uint64_t high_high = a_high * b_high;
+
+            const uint64_t middle = (low_low >> 32) + static_cast<uint32_t>(high_low) + low_high;
+
+            a = (middle << 32) | static_cast<uint32_t>(low_low);
+            b = high_high + (high_low >> 32) + (middle >> 32);
+#endif
+        }
+
+        static uint64_t Load64(const uint8_t* p)
+        {
+            uint64_t val;
+
+            std::memcpy(&val, p, sizeof(val));
+
+            if constexpr (std::endian::native == std::endian::big)
+            {
+                val = std::byteswap(val);
+            }
+
+            return val;
+        }
+
+        static uint64_t Load32(const uint8_t* p)
+        {
+            uint32_t val;
+
+            std::memcpy(&val, p, sizeof(val));
+
+            if constexpr (std::endian::native == std::endian::big)
+            {
+                val = std::byteswap(val);
+            }
+
+            return val;
+        }
+
+        static uint64_t HashShort(const uint8_t* p, size_t size, uint64_t seed)
+        {
+            seed ^= Mix(seed ^ secret[0], secret[1]);
+
+            uint64_t a;
+            uint64_t b;
+
+            if (size <= 16)
+            {
+                if (size >= 4)
+                {
+                    //Two overlapping pairs of 32 bit words cover 4 - 16 bytes.
+                    const size_t offset = (size >> 3) << 2;
+
+                    a = (Load32(p) << 32) | Load32(p + offset);
+                    b = (Load32(p + size - 4) << 32) | Load32(p + size - 4 - offset);
+                }
+                else if (size > 0)
+                {
+                    a = (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[size >> 1]) << 8) | p[size - 1];
+                    b = 0;
+                }
+                else
+                {
+                    a = b = 0;
+                }
+            }
+            else
+            {
+                size_t i = size;
+
+                if (i > 48)
+                {
+                    uint64_t seed1 = seed;
+                    uint64_t seed2 = seed;
+
+                    do
+                    {
+                        seed = Mix(Load64(p) ^ secret[1], Load64(p + 8) ^ seed);
+                        seed1 = Mix(Load64(p + 16) ^ secret[2], Load64(p + 24) ^ seed1);
+                        seed2 = Mix(Load64(p + 32) ^ secret[3], Load64(p + 40) ^ seed2);
+
+                        p += 48;
+                        i -= 48;
+                    }
+                    while (i > 48);
+
+                    seed ^= seed1 ^ seed2;
+                }
+
+                while (i > 16)
+                {
+                    seed = Mix(Load64(p) ^ secret[1], Load64(p + 8) ^ seed);
+
+                    p += 16;
+                    i -= 16;
+                }
+
+                //The last 16 bytes, possibly overlapping the previous ones.
+                a = Load64(p + i - 16);
+                b = Load64(p + i - 8);
+            }
+
+            a ^= secret[1];
+            b ^= seed;
+
+            Multiply(a, b);
+
+            return Mix(a ^ secret[0] ^ size, b ^ secret[1]);
+        }
+
+        static void AccumulateStripeScalar(uint64_t* acc, const uint8_t* p, const uint64_t* key)
+        {
+            for (size_t j = 0; j < laneCount; ++j)
+            {
+                const uint64_t data = Load64(p + j * sizeof(uint64_t));
+
+                const uint64_t keyed = data ^ key[j];
+
+                //The data also goes to the neighbour lane, so it is not lost if the product is zero.
+                acc[j ^ 1] += data;
+
+                acc[j] += (keyed & 0xFFFFFFFF) * (keyed >> 32);
+            }
+        }
+
+        static void ScrambleScalar(uint64_t* acc)
+        {
+            for (size_t j = 0; j < laneCount; ++j)
+            {
+                uint64_t a = acc[j];
+
+                a ^= a >> 47;
+                a ^= secret[scrambleOffset + j];
+                a *= prime32;
+
+                acc[j] = a;
+            }
+        }
+
+#ifdef AWL_FAST_HASH_SSE2
+
+        static __m128i LoadKey(const uint64_t* key)
+        {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+        }
+
+        static void AccumulateStripeSse2(__m128i* acc, const uint8_t* p, const uint64_t* key)
+        {
+            for (size_t j = 0; j < laneCount / 2; ++j)
+            {
+                const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p) + j);
+
+                const __m128i keyed = _mm_xor_si128(data, LoadKey(key + j * 2));
+
+                const __m128i product = _mm_mul_epu32(keyed, _mm_srli_epi64(keyed, 32));
+
+                const __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+
+                acc[j] = _mm_add_epi64(acc[j], _mm_add_epi64(product, swapped));
+            }
+        }
+
+        static void ScrambleSse2(__m128i* acc)
+        {
+            const __m128i prime = _mm_set1_epi32(static_cast<int>(prime32));
+
+            for (size_t j = 0; j < laneCount / 2; ++j)
+            {
+                __m128i a = acc[j];
+
+                a = _mm_xor_si128(a, _mm_srli_epi64(a, 47));
+                a = _mm_xor_si128(a, LoadKey(secret.data() + scrambleOffset + j * 2));
+
+                //64x32 bit multiplication.
+                const __m128i low = _mm_mul_epu32(a, prime);
+                const __m128i high = _mm_mul_epu32(_mm_srli_epi64(a, 32), prime);
+
+                acc[j] = _mm_add_epi64(low, _mm_slli_epi64(high, 32));
+            }
+        }
+
+#endif
+
+        //The size is greater than shortSize.
+        template <bool simd>
+        static std::array<uint64_t, laneCount> Accumulate(const uint8_t* p, size_t size, uint64_t seed)
+        {
+            std::array<uint64_t, laneCount> acc;
+
+            for (size_t j = 0; j < laneCount; ++j)
+            {
+                acc[j] = secret[initOffset + j] ^ seed;
+            }
+
+            //At least one byte is left for the last stripe.
+            const size_t stripe_count = (size - 1) / stripeSize;
+
+            auto process = [p, stripe_count](auto* lanes, auto accumulate, auto scramble)
+            {
+                for (size_t i = 0; i < stripe_count; ++i)
+                {
+                    const size_t stripe = i % blockStripeCount;
+
+                    accumulate(lanes, p + i * stripeSize, secret.data() + stripe);
+
+                    if (stripe == blockStripeCount - 1)
+                    {
+                        scramble(lanes);
+                    }
+                }
+            };
+
+            const uint8_t* last = p + size - stripeSize;
+
+#ifdef AWL_FAST_HASH_SSE2
+            if constexpr (simd)
+            {
+                __m128i lanes[laneCount / 2];
+
+                for (size_t j = 0; j < laneCount / 2; ++j)
+                {
+                    lanes[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc.data()) + j);
+                }
+
+                process(lanes, &AccumulateStripeSse2, &ScrambleSse2);
+
+                AccumulateStripeSse2(lanes, last, secret.data() + blockStripeCount);
+
+                for (size_t j = 0; j < laneCount / 2; ++j)
+                {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(acc.data()) + j, lanes[j]);
+                }
+
+                return acc;
+            }
+#endif
+            process(acc.data(), &AccumulateStripeScalar, &ScrambleScalar);
+
+            AccumulateStripeScalar(acc.data(), last, secret.data() + blockStripeCount);
+
+            return acc;
+        }
+
+        static uint64_t Merge(const std::array<uint64_t, laneCount>& acc, size_t size, size_t offset)
+        {
+            uint64_t h = static_cast<uint64_t>(size) * UINT64_C(0x9E3779B185EBCA87);
+
+            for (size_t j = 0; j < laneCount; j += 2)
+            {
+                h += Mix(acc[j] ^ secret[offset + j], acc[j + 1] ^ secret[offset + j + 1]);
+            }
+
+            h ^= h >> 37;
+            h *= UINT64_C(0x165667919E3779F9);
+            h ^= h >> 32;
+
+            return h;
+        }
+    };
+
+    inline constexpr FastHashFunctions::Secret FastHashFunctions::secret = FastHashFunctions::MakeSecret();
+
+    //N is 8 or 16.
+    template <size_t N>
+    class FastHash : public BasicHash<N>
+    {
+    private:
+
+        using Base = BasicHash<N>;
+
+        static_assert(N == sizeof(uint64_t) || N == sizeof(uint64_t) * 2);
+
+    public:
+
+        using value_type = typename Base::value_type;
+
+        constexpr FastHash(uint64_t seed = 0) : m_seed(seed) {}
+
+        template <class InputIt>
+            requires std::is_arithmetic<typename std::iterator_traits<InputIt>::value_type>::value
+        value_type operator()(InputIt begin, InputIt end) const
+        {
+            using T = typename std::iterator_traits<InputIt>::value_type;
+
+            if constexpr (std::contiguous_iterator<InputIt>)
+            {
+                const auto size = static_cast<size_t>(end - begin) * sizeof(T);
+
+                return Calculate(reinterpret_cast<const uint8_t*>(std::to_address(begin)), size);
+            }
+            else
+            {
+                //The bytes of the elements are collected into a temporary buffer.
+                std::vector<uint8_t> bytes;
+
+                for (InputIt i = begin; i != end; ++i)
+                {
+                    const auto buffer = to_buffer(static_cast<T>(*i));
+
+                    bytes.insert(bytes.end(), buffer.begin(), buffer.end());
+                }
+
+                return Calculate(bytes.data(), bytes.size());
+            }
+        }
+
+    private:
+
+        value_type Calculate(const uint8_t* p, size_t size) const
+        {
+            if constexpr (N == sizeof(uint64_t))
+            {
+                return to_buffer(FastHashFunctions::Hash64(p, size, m_seed));
+            }
+            else
+            {
+                return to_buffer(FastHashFunctions::Hash128(p, size, m_seed));
+            }
+        }
+
+        uint64_t m_seed;
+    };
+
+    using FastHash64 = FastHash<sizeof(uint64_t)>;
+
+    using FastHash128 = FastHash<sizeof(uint64_t) * 2>;
+}
@@ -0,0 +1,111 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Awl/Crypto/Crc64.h"
+#include "Awl/CppStd/Thread.h"
+
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <cassert>
+
+namespace awl::crypto
+{
+    //Calculates the same value as Crc64, but a large contiguous range is split into chunks hashed by separate threads
+    //and their CRCs are combined. It can be used by HashOutputStream and HashInputStream with very large blocks.
+    class ParallelCrc64 : public BasicHash<sizeof(uint64_t)>
+    {
+    public:
+
+        static constexpr size_t defaultMinChunkSize = 1024 * 1024;
+
+        ParallelCrc64(uint64_t seed = 127, size_t thread_count = DefaultThreadCount(),
+            size_t min_chunk_size = defaultMinChunkSize) :
+            m_seed(seed),
+            m_threadCount(thread_count),
+            m_minChunkSize(min_chunk_size)
+        {
+            assert(m_threadCount != 0);
+            assert(m_minChunkSize != 0);
+        }
+
+        template <class InputIt>
+            requires std::is_arithmetic<typename std::iterator_traits<InputIt>::value_type>::value
+        value_type operator()(InputIt begin, InputIt end) const
+        {
+            if constexpr (std::contiguous_iterator<InputIt>)
+            {
+                using T = typename std::iterator_traits<InputIt>::value_type;
+
+                const auto size = static_cast<size_t>(end - begin) * sizeof(T);
+
+                return to_buffer(Update(m_seed, reinterpret_cast<const uint8_t*>(std::to_address(begin)), size));
+            }
+            else
+            {
+                return Crc64(m_seed)(begin, end);
+            }
+        }
+
+        //Continues the CRC of the preceding data with the next size bytes.
+        uint64_t Update(uint64_t crc, const uint8_t* p, size_t size) const
+        {
+            const size_t chunk_count = std::min(m_threadCount, size / m_minChunkSize);
+
+            if (chunk_count <= 1)
+            {
+                return Crc64::Update(crc, p, size);
+            }
+
+            const size_t chunk_size = size / chunk_count;
+
+            //The last chunk also takes the remainder.
+            auto get_chunk_size = [chunk_count, chunk_size, size](size_t i)
+            {
+                return i == chunk_count - 1 ? size - i * chunk_size : chunk_size;
+            };
+
+            //The chunks except the first one start with zero, so they can be combined.
+            std::vector<uint64_t> crcs(chunk_count);
+
+            {
+                std::vector<std::jthread> threads;
+
+                threads.reserve(chunk_count - 1);
+
+                for (size_t i = 1; i < chunk_count; ++i)
+                {
+                    threads.emplace_back([&crcs, &get_chunk_size, p, chunk_size, i]()
+                    {
+                        crcs[i] = Crc64::Update(0, p + i * chunk_size, get_chunk_size(i));
+                    });
+                }
+
+                //The calling thread hashes the first chunk.
+                crcs[0] = Crc64::Update(crc, p, chunk_size);
+            }
+
+            crc = crcs[0];
+
+            for (size_t i = 1; i < chunk_count; ++i)
+            {
+                crc = Crc64::Combine(crc, crcs[i], get_chunk_size(i));
+            }
+
+            return crc;
+        }
+
+    private:
+
+        uint64_t m_seed;
+
+        size_t m_threadCount;
+
+        size_t m_minChunkSize;
+    };
+}
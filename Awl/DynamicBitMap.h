@@ -0,0 +1,570 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <vector>
+#include <span>
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <ranges>
+
+namespace awl
+{
+    //A runtime sized bitset stored as 64-bit words. The bulk operations are simple loops over the words
+    //that the compiler vectorizes, rank() and select() use an optional index built with build_rank_index().
+    template <class Allocator = std::allocator<uint64_t>>
+    class basic_dynamic_bitmap
+    {
+    public:
+
+        using word_type = uint64_t;
+        using size_type = std::size_t;
+        using allocator_type = Allocator;
+
+        static constexpr size_type word_bits = 64;
+
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+    private:
+
+        using WordVector = std::vector<word_type, Allocator>;
+
+        //The index contains the number of set bits before each block.
+        static constexpr size_type blockWords = 8;
+        static constexpr size_type blockBits = blockWords * word_bits;
+
+    public:
+
+        //Iterates over the indices of the set bits.
+        class set_bit_iterator
+        {
+        public:
+
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = size_type;
+            using difference_type = std::ptrdiff_t;
+            using reference = size_type;
+            using pointer = void;
+
+            set_bit_iterator() = default;
+
+            size_type operator* () const
+            {
+                return m_index * word_bits + static_cast<size_type>(std::countr_zero(m_word));
+            }
+
+            set_bit_iterator& operator++ ()
+            {
+                m_word &= m_word - 1;
+
+                skip_zeros();
+
+                return *this;
+            }
+
+            set_bit_iterator operator++ (int)
+            {
+                set_bit_iterator tmp = *this;
+
+                ++(*this);
+
+                return tmp;
+            }
+
+            bool operator == (const set_bit_iterator& other) const
+            {
+                return m_index == other.m_index && m_word == other.m_word;
+            }
+
+            bool operator != (const set_bit_iterator& other) const
+            {
+                return !(*this == other);
+            }
+
+        private:
+
+            set_bit_iterator(const word_type* p_words, size_type count, size_type index) :
+                m_pWords(p_words), m_count(count), m_index(index), m_word(index < count ? p_words[index] : 0)
+            {
+                skip_zeros();
+            }
+
+            void skip_zeros()
+            {
+                while (m_word == 0 && m_index < m_count)
+                {
+                    if (++m_index < m_count)
+                    {
+                        m_word = m_pWords[m_index];
+                    }
+                }
+            }
+
+            const word_type* m_pWords = nullptr;
+
+            size_type m_count = 0;
+
+            size_type m_index = 0;
+
+            //The bits of the current word that are not visited yet.
+            word_type m_word = 0;
+
+            friend basic_dynamic_bitmap;
+        };
+
+        basic_dynamic_bitmap() = default;
+
+        explicit basic_dynamic_bitmap(size_type size, bool value = false, const Allocator& alloc = Allocator()) :
+            m_words(word_count(size), value ? ~word_type{} : word_type{}, alloc),
+            m_size(size)
+        {
+            trim();
+        }
+
+        //The bits beyond the size are ignored.
+        basic_dynamic_bitmap(size_type size, WordVector words) : m_words(std::move(words)), m_size(size)
+        {
+            if (m_words.size() != word_count(size))
+            {
+                throw std::invalid_argument("The number of words does not match the bitmap size.");
+            }
+
+            trim();
+        }
+
+        size_type size() const
+        {
+            return m_size;
+        }
+
+        bool empty() const
+        {
+            return m_size == 0;
+        }
+
+        void resize(size_type size, bool value = false)
+        {
+            const size_type old_size = m_size;
+
+            m_words.resize(word_count(size), value ? ~word_type{} : word_type{});
+
+            m_size = size;
+
+            if (value && old_size < size && old_size % word_bits != 0)
+            {
+                m_words[old_size / word_bits] |= ~word_type{} << (old_size % word_bits);
+            }
+
+            trim();
+
+            invalidate_index();
+        }
+
+        void clear()
+        {
+            m_words.clear();
+            m_size = 0;
+
+            invalidate_index();
+        }
+
+        bool test(size_type pos) const
+        {
+            assert(pos < m_size);
+
+            return (m_words[pos / word_bits] >> (pos % word_bits) & 1u) != 0;
+        }
+
+        bool operator[](size_type pos) const
+        {
+            return test(pos);
+        }
+
+        basic_dynamic_bitmap& set(size_type pos, bool value = true)
+        {
+            assert(pos < m_size);
+
+            const word_type mask = word_type{ 1 } << (pos % word_bits);
+
+            word_type& word = m_words[pos / word_bits];
+
+            word = value ? word | mask : word & ~mask;
+
+            invalidate_index();
+
+            return *this;
+        }
+
+        basic_dynamic_bitmap& reset(size_type pos)
+        {
+            return set(pos, false);
+        }
+
+        basic_dynamic_bitmap& flip(size_type pos)
+        {
+            assert(pos < m_size);
+
+            m_words[pos / word_bits] ^= word_type{ 1 } << (pos % word_bits);
+
+            invalidate_index();
+
+            return *this;
+        }
+
+        basic_dynamic_bitmap& set()
+        {
+            std::ranges::fill(m_words, ~word_type{});
+
+            trim();
+
+            invalidate_index();
+
+            return *this;
+        }
+
+        basic_dynamic_bitmap& reset()
+        {
+            std::ranges::fill(m_words, word_type{});
+
+            invalidate_index();
+
+            return *this;
+        }
+
+        basic_dynamic_bitmap& flip()
+        {
+            for (word_type& word : m_words)
+            {
+                word = ~word;
+            }
+
+            trim();
+
+            invalidate_index();
+
+            return *this;
+        }
+
+        size_type count() const
+        {
+            return count_words(0, m_words.size());
+        }
+
+        bool any() const
+        {
+            return std::ranges::any_of(m_words, [](word_type word) { return word != 0; });
+        }
+
+        bool none() const
+        {
+            return !any();
+        }
+
+        bool all() const
+        {
+            return count() == m_size;
+        }
+
+        basic_dynamic_bitmap& operator &= (const basic_dynamic_bitmap& other)
+        {
+            return apply(other, [](word_type a, word_type b) { return a & b; });
+        }
+
+        basic_dynamic_bitmap& operator |= (const basic_dynamic_bitmap& other)
+        {
+            return apply(other, [](word_type a, word_type b) { return a | b; });
+        }
+
+        basic_dynamic_bitmap& operator ^= (const basic_dynamic_bitmap& other)
+        {
+            return apply(other, [](word_type a, word_type b) { return a ^ b; });
+        }
+
+        //Clears the bits that are set in other.
+        basic_dynamic_bitmap& and_not(const basic_dynamic_bitmap& other)
+        {
+            return apply(other, [](word_type a, word_type b) { return a & ~b; });
+        }
+
+        basic_dynamic_bitmap operator & (const basic_dynamic_bitmap& other) const
+        {
+            basic_dynamic_bitmap result = *this;
+            result &= other;
+            return result;
+        }
+
+        basic_dynamic_bitmap operator | (const basic_dynamic_bitmap& other) const
+        {
+            basic_dynamic_bitmap result = *this;
+            result |= other;
+            return result;
+        }
+
+        basic_dynamic_bitmap operator ^ (const basic_dynamic_bitmap& other) const
+        {
+            basic_dynamic_bitmap result = *this;
+            result ^= other;
+            return result;
+        }
+
+        basic_dynamic_bitmap operator ~ () const
+        {
+            basic_dynamic_bitmap result = *this;
+            result.flip();
+            return result;
+        }
+
+        //The number of set bits in the intersection without building it.
+        size_type count_and(const basic_dynamic_bitmap& other) const
+        {
+            assert(m_size == other.m_size);
+
+            size_type n = 0;
+
+            for (size_type i = 0; i < m_words.size(); ++i)
+            {
+                n += static_cast<size_type>(std::popcount(m_words[i] & other.m_words[i]));
+            }
+
+            return n;
+        }
+
+        //Makes rank() and select() O(1) and O(log N) until the bitmap is modified.
+        void build_rank_index()
+        {
+            const size_type block_count = (m_words.size() + blockWords - 1) / blockWords;
+
+            m_ranks.resize(block_count + 1);
+
+            size_type n = 0;
+
+            for (size_type block = 0; block < block_count; ++block)
+            {
+                m_ranks[block] = n;
+
+                n += count_words(block * blockWords, std::min((block + 1) * blockWords, m_words.size()));
+            }
+
+            m_ranks[block_count] = n;
+        }
+
+        bool has_rank_index() const
+        {
+            return !m_ranks.empty();
+        }
+
+        //The number of set bits in [0, pos).
+        size_type rank(size_type pos) const
+        {
+            assert(pos <= m_size);
+
+            const size_type word_index = pos / word_bits;
+
+            size_type n;
+            size_type first_word;
+
+            if (has_rank_index())
+            {
+                const size_type block = word_index / blockWords;
+
+                n = m_ranks[block];
+                first_word = block * blockWords;
+            }
+            else
+            {
+                n = 0;
+                first_word = 0;
+            }
+
+            n += count_words(first_word, word_index);
+
+            if (pos % word_bits != 0)
+            {
+                n += static_cast<size_type>(std::popcount(m_words[word_index] & low_mask(pos % word_bits)));
+            }
+
+            return n;
+        }
+
+        //The position of the set bit with the specified zero-based rank or npos.
+        size_type select(size_type k) const
+        {
+            size_type word_index = 0;
+
+            if (has_rank_index())
+            {
+                //The last block with the number of the preceding bits <= k.
+                auto i = std::ranges::upper_bound(m_ranks, k);
+
+                if (i == m_ranks.end())
+                {
+                    return npos;
+                }
+
+                const size_type block = static_cast<size_type>(i - m_ranks.begin()) - 1;
+
+                k -= m_ranks[block];
+                word_index = block * blockWords;
+            }
+
+            for (; word_index < m_words.size(); ++word_index)
+            {
+                const size_type n = static_cast<size_type>(std::popcount(m_words[word_index]));
+
+                if (k < n)
+                {
+                    return word_index * word_bits + select_in_word(m_words[word_index], k);
+                }
+
+                k -= n;
+            }
+
+            return npos;
+        }
+
+        set_bit_iterator set_bits_begin() const
+        {
+            return set_bit_iterator(m_words.data(), m_words.size(), 0);
+        }
+
+        set_bit_iterator set_bits_end() const
+        {
+            return set_bit_iterator(m_words.data(), m_words.size(), m_words.size());
+        }
+
+        std::ranges::subrange<set_bit_iterator> set_bits() const
+        {
+            return { set_bits_begin(), set_bits_end() };
+        }
+
+        //The first set bit at or after pos or npos.
+        size_type find_next(size_type pos) const
+        {
+            if (pos >= m_size)
+            {
+                return npos;
+            }
+
+            size_type word_index = pos / word_bits;
+
+            word_type word = m_words[word_index] & ~low_mask(pos % word_bits);
+
+            while (word == 0)
+            {
+                if (++word_index == m_words.size())
+                {
+                    return npos;
+                }
+
+                word = m_words[word_index];
+            }
+
+            return word_index * word_bits + static_cast<size_type>(std::countr_zero(word));
+        }
+
+        size_type find_first() const
+        {
+            return find_next(0);
+        }
+
+        //The bits beyond size() are always zero.
+        std::span<const word_type> words() const
+        {
+            return m_words;
+        }
+
+        bool operator == (const basic_dynamic_bitmap& other) const
+        {
+            return m_size == other.m_size && m_words == other.m_words;
+        }
+
+        bool operator != (const basic_dynamic_bitmap& other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+
+        static constexpr size_type word_count(size_type size)
+        {
+            return (size + word_bits - 1) / word_bits;
+        }
+
+        static constexpr word_type low_mask(size_type bit_count)
+        {
+            return bit_count == 0 ? word_type{} : ~word_type{} >> (word_bits - bit_count);
+        }
+
+        static size_type select_in_word(word_type word, size_type k)
+        {
+            for (size_type i = 0; i < k; ++i)
+            {
+                word &= word - 1;
+            }
+
+            return static_cast<size_type>(std::countr_zero(word));
+        }
+
+        size_type count_words(size_type first, size_type last) const
+        {
+            size_type n = 0;
+
+            for (size_type i = first; i < last; ++i)
+            {
+                n += static_cast<size_type>(std::popcount(m_words[i]));
+            }
+
+            return n;
+        }
+
+        template <class Func>
+        basic_dynamic_bitmap& apply(const basic_dynamic_bitmap& other, Func func)
+        {
+            assert(m_size == other.m_size);
+
+            word_type* p_dst = m_words.data();
+            const word_type* p_src = other.m_words.data();
+
+            const size_type n = m_words.size();
+
+            for (size_type i = 0; i < n; ++i)
+            {
+                p_dst[i] = func(p_dst[i], p_src[i]);
+            }
+
+            invalidate_index();
+
+            return *this;
+        }
+
+        //Clears the bits beyond the size.
+        void trim()
+        {
+            if (m_size % word_bits != 0)
+            {
+                m_words.back() &= low_mask(m_size % word_bits);
+            }
+        }
+
+        void invalidate_index()
+        {
+            m_ranks.clear();
+        }
+
+        WordVector m_words;
+
+        size_type m_size = 0;
+
+        std::vector<size_type> m_ranks;
+    };
+
+    using dynamic_bitmap = basic_dynamic_bitmap<>;
+}
@@ -0,0 +1,873 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Awl/Hashable.h"
+
+#include <memory>
+#include <utility>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+#include <stdexcept>
+#include <type_traits>
+
+namespace awl
+{
+    namespace helpers
+    {
+        //A group of control bytes that is matched in a single 64-bit word (SWAR).
+        class FlatHashGroup
+        {
+        public:
+
+            static constexpr size_t width = 8;
+
+            static constexpr int8_t emptyByte = static_cast<int8_t>(0x80);
+            static constexpr int8_t deletedByte = static_cast<int8_t>(0xFE);
+
+            explicit FlatHashGroup(const int8_t* p_ctrl)
+            {
+                std::memcpy(&m_word, p_ctrl, sizeof(m_word));
+
+                if constexpr (std::endian::native == std::endian::big)
+                {
+                    m_word = std::byteswap(m_word);
+                }
+            }
+
+            //The bytes equal to h2, can have false positives that are filtered out by the key comparison.
+            uint64_t Match(uint8_t h2) const
+            {
+                const uint64_t x = m_word ^ (lsbs * h2);
+
+                return (x - lsbs) & ~x & msbs;
+            }
+
+            uint64_t MatchEmpty() const
+            {
+                return m_word & ~(m_word << 6) & msbs;
+            }
+
+            uint64_t MatchEmptyOrDeleted() const
+            {
+                return m_word & msbs;
+            }
+
+            //The index of the byte the lowest bit of the mask belongs to.
+            static size_t LowestIndex(uint64_t mask)
+            {
+                return static_cast<size_t>(std::countr_zero(mask)) / 8;
+            }
+
+        private:
+
+            static constexpr uint64_t lsbs = 0x0101010101010101ull;
+            static constexpr uint64_t msbs = 0x8080808080808080ull;
+
+            uint64_t m_word;
+        };
+
+        template <class Value>
+        struct SetKeyGetter
+        {
+            const Value& operator()(const Value& val) const
+            {
+                return val;
+            }
+        };
+
+        template <class Value>
+        struct MapKeyGetter
+        {
+            const auto& operator()(const Value& val) const
+            {
+                return val.first;
+            }
+        };
+
+        //Open addressing hash table with the control bytes stored separately from the slots.
+        //The probe sequence visits the groups of the slots, a group is matched with a few word operations.
+        template <class Value, class Key, class GetKey, class Hash, class KeyEqual, class Allocator>
+        class FlatHashTable
+        {
+        private:
+
+            using Group = FlatHashGroup;
+
+            using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Value>;
+            using SlotAllocatorTraits = std::allocator_traits<SlotAllocator>;
+            using CtrlAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<int8_t>;
+
+            template <class K>
+            static constexpr bool is_lookup_key = std::is_convertible_v<const K&, const Key&> ||
+                (requires { typename Hash::is_transparent; typename KeyEqual::is_transparent; });
+
+            template <class Table, class V>
+            class MyIterator
+            {
+            public:
+
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = std::remove_const_t<V>;
+                using difference_type = std::ptrdiff_t;
+                using reference = V&;
+                using pointer = V*;
+
+                MyIterator() = default;
+
+                reference operator* () const
+                {
+                    return m_pTable->m_slots[m_index];
+                }
+
+                pointer operator-> () const
+                {
+                    return m_pTable->m_slots + m_index;
+                }
+
+                MyIterator& operator++ ()
+                {
+                    ++m_index;
+
+                    SkipFree();
+
+                    return *this;
+                }
+
+                MyIterator operator++ (int)
+                {
+                    MyIterator tmp = *this;
+
+                    ++(*this);
+
+                    return tmp;
+                }
+
+                bool operator == (const MyIterator& other) const
+                {
+                    return m_index == other.m_index;
+                }
+
+                bool operator != (const MyIterator& other) const
+                {
+                    return !(*this == other);
+                }
+
+                // Conversion to const_iterator
+                operator MyIterator<const Table, const V>() const
+                {
+                    return MyIterator<const Table, const V>(m_pTable, m_index);
+                }
+
+            private:
+
+                MyIterator(Table* p_table, size_t index) : m_pTable(p_table), m_index(index)
+                {
+                }
+
+                void SkipFree()
+                {
+                    while (m_index < m_pTable->m_capacity && m_pTable->m_ctrl[m_index] < 0)
+                    {
+                        ++m_index;
+                    }
+                }
+
+                Table* m_pTable = nullptr;
+
+                size_t m_index = 0;
+
+                friend FlatHashTable;
+            };
+
+        public:
+
+            using key_type = Key;
+            using value_type = Value;
+            using size_type = std::size_t;
+            using difference_type = std::ptrdiff_t;
+            using hasher = Hash;
+            using key_equal = KeyEqual;
+            using allocator_type = Allocator;
+            using reference = value_type&;
+            using const_reference = const value_type&;
+
+            using iterator = MyIterator<FlatHashTable, Value>;
+            using const_iterator = MyIterator<const FlatHashTable, const Value>;
+
+            FlatHashTable() = default;
+
+            explicit FlatHashTable(size_type count, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual(), const Allocator& alloc = Allocator()) :
+                m_hash(hash), m_equal(equal), m_slotAlloc(alloc), m_ctrlAlloc(alloc)
+            {
+                reserve(count);
+            }
+
+            FlatHashTable(std::initializer_list<value_type> init) : FlatHashTable(init.size())
+            {
+                insert(init.begin(), init.end());
+            }
+
+            FlatHashTable(const FlatHashTable& other) :
+                m_hash(other.m_hash), m_equal(other.m_equal),
+                m_slotAlloc(SlotAllocatorTraits::select_on_container_copy_construction(other.m_slotAlloc)),
+                m_ctrlAlloc(m_slotAlloc)
+            {
+                if (!other.empty())
+                {
+                    reserve(other.size());
+
+                    for (const value_type& val : other)
+                    {
+                        InsertUnique(HashOf(GetKey()(val)), val);
+                    }
+                }
+            }
+
+            FlatHashTable(FlatHashTable&& other) noexcept :
+                m_hash(std::move(other.m_hash)), m_equal(std::move(other.m_equal)),
+                m_slotAlloc(std::move(other.m_slotAlloc)), m_ctrlAlloc(std::move(other.m_ctrlAlloc))
+            {
+                Steal(other);
+            }
+
+            ~FlatHashTable()
+            {
+                Destroy();
+            }
+
+            FlatHashTable& operator = (const FlatHashTable& other)
+            {
+                if (this != &other)
+                {
+                    FlatHashTable copy(other);
+
+                    swap(copy);
+                }
+
+                return *this;
+            }
+
+            FlatHashTable& operator = (FlatHashTable&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    Destroy();
+
+                    m_hash = std::move(other.m_hash);
+                    m_equal = std::move(other.m_equal);
+                    m_slotAlloc = std::move(other.m_slotAlloc);
+                    m_ctrlAlloc = std::move(other.m_ctrlAlloc);
+
+                    Steal(other);
+                }
+
+                return *this;
+            }
+
+            void swap(FlatHashTable& other) noexcept
+            {
+                std::swap(m_hash, other.m_hash);
+                std::swap(m_equal, other.m_equal);
+                std::swap(m_slotAlloc, other.m_slotAlloc);
+                std::swap(m_ctrlAlloc, other.m_ctrlAlloc);
+                std::swap(m_ctrl, other.m_ctrl);
+                std::swap(m_slots, other.m_slots);
+                std::swap(m_capacity, other.m_capacity);
+                std::swap(m_size, other.m_size);
+                std::swap(m_growthLeft, other.m_growthLeft);
+            }
+
+            iterator begin()
+            {
+                iterator i(this, 0);
+                i.SkipFree();
+                return i;
+            }
+
+            const_iterator begin() const
+            {
+                const_iterator i(this, 0);
+                i.SkipFree();
+                return i;
+            }
+
+            iterator end() { return iterator(this, m_capacity); }
+            const_iterator end() const { return const_iterator(this, m_capacity); }
+
+            const_iterator cbegin() const { return begin(); }
+            const_iterator cend() const { return end(); }
+
+            size_type size() const
+            {
+                return m_size;
+            }
+
+            bool empty() const
+            {
+                return m_size == 0;
+            }
+
+            size_type bucket_count() const
+            {
+                return m_capacity;
+            }
+
+            float load_factor() const
+            {
+                return m_capacity == 0 ? 0.0f : static_cast<float>(m_size) / static_cast<float>(m_capacity);
+            }
+
+            hasher hash_function() const
+            {
+                return m_hash;
+            }
+
+            key_equal key_eq() const
+            {
+                return m_equal;
+            }
+
+            void reserve(size_type count)
+            {
+                const size_type capacity = CapacityFor(count);
+
+                if (capacity > m_capacity)
+                {
+                    Rehash(capacity);
+                }
+            }
+
+            void clear()
+            {
+                if (m_capacity != 0)
+                {
+                    DestroySlots();
+
+                    std::fill(m_ctrl, m_ctrl + m_capacity, Group::emptyByte);
+
+                    m_size = 0;
+                    m_growthLeft = MaxLoad(m_capacity);
+                }
+            }
+
+            template <class K>
+                requires is_lookup_key<K>
+            iterator find(const K& key)
+            {
+                return iterator(this, FindIndex(key, HashOf(key)));
+            }
+
+            template <class K>
+                requires is_lookup_key<K>
+            const_iterator find(const K& key) const
+            {
+                return const_iterator(this, FindIndex(key, HashOf(key)));
+            }
+
+            template <class K>
+                requires is_lookup_key<K>
+            bool contains(const K& key) const
+            {
+                return FindIndex(key, HashOf(key)) != m_capacity;
+            }
+
+            template <class K>
+                requires is_lookup_key<K>
+            size_type count(const K& key) const
+            {
+                return contains(key) ? 1 : 0;
+            }
+
+            std::pair<iterator, bool> insert(const value_type& val)
+            {
+                return InsertImpl(GetKey()(val), val);
+            }
+
+            std::pair<iterator, bool> insert(value_type&& val)
+            {
+                return InsertImpl(GetKey()(val), std::move(val));
+            }
+
+            template <class InputIt>
+            void insert(InputIt first, InputIt last)
+            {
+                for (; first != last; ++first)
+                {
+                    insert(*first);
+                }
+            }
+
+            void insert(std::initializer_list<value_type> init)
+            {
+                insert(init.begin(), init.end());
+            }
+
+            //The value is constructed before the lookup.
+            template <class... Args>
+            std::pair<iterator, bool> emplace(Args&&... args)
+            {
+                value_type val(std::forward<Args>(args)...);
+
+                return insert(std::move(val));
+            }
+
+            template <class K>
+                requires is_lookup_key<K>
+            size_type erase(const K& key)
+            {
+                const size_t index = FindIndex(key, HashOf(key));
+
+                if (index == m_capacity)
+                {
+                    return 0;
+                }
+
+                EraseIndex(index);
+
+                return 1;
+            }
+
+            iterator erase(const_iterator i)
+            {
+                assert(i.m_index < m_capacity && m_ctrl[i.m_index] >= 0);
+
+                EraseIndex(i.m_index);
+
+                iterator next(this, i.m_index + 1);
+                next.SkipFree();
+
+                return next;
+            }
+
+            iterator erase(iterator i)
+            {
+                return erase(const_iterator(i));
+            }
+
+            bool operator == (const FlatHashTable& other) const
+            {
+                if (size() != other.size())
+                {
+                    return false;
+                }
+
+                for (const value_type& val : *this)
+                {
+                    auto i = other.find(GetKey()(val));
+
+                    if (i == other.end() || !(*i == val))
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            bool operator != (const FlatHashTable& other) const
+            {
+                return !(*this == other);
+            }
+
+        protected:
+
+            //Inserts the value constructed from the arguments if the key does not exist.
+            template <class K, class... Args>
+            std::pair<iterator, bool> InsertImpl(const K& key, Args&&... args)
+            {
+                const size_t h = HashOf(key);
+
+                const size_t index = FindIndex(key, h);
+
+                if (index != m_capacity)
+                {
+                    return { iterator(this, index), false };
+                }
+
+                return { iterator(this, InsertUnique(h, std::forward<Args>(args)...)), true };
+            }
+
+        private:
+
+            static constexpr size_t MaxLoad(size_t capacity)
+            {
+                return capacity - capacity / 8;
+            }
+
+            static constexpr size_t CapacityFor(size_t count)
+            {
+                size_t capacity = Group::width;
+
+                while (MaxLoad(capacity) < count)
+                {
+                    capacity *= 2;
+                }
+
+                return capacity;
+            }
+
+            //std::hash of integers is usually identity, so the hash is mixed before it is split into H1 and H2.
+            template <class K>
+            size_t HashOf(const K& key) const
+            {
+                uint64_t h = static_cast<uint64_t>(m_hash(key)) * 0x9E3779B97F4A7C15ull;
+
+                return static_cast<size_t>(h ^ (h >> 32));
+            }
+
+            static uint8_t H2(size_t h)
+            {
+                return static_cast<uint8_t>(h & 0x7F);
+            }
+
+            size_t GroupMask() const
+            {
+                return m_capacity / Group::width - 1;
+            }
+
+            //Returns m_capacity if the key is not found.
+            template <class K>
+            size_t FindIndex(const K& key, size_t h) const
+            {
+                if (m_size == 0)
+                {
+                    return m_capacity;
+                }
+
+                const size_t mask = GroupMask();
+
+                size_t group = (h >> 7) & mask;
+
+                for (size_t step = 1; ; ++step)
+                {
+                    const size_t base = group * Group::width;
+
+                    const Group g(m_ctrl + base);
+
+                    for (uint64_t match = g.Match(H2(h)); match != 0; match &= match - 1)
+                    {
+                        const size_t index = base + Group::LowestIndex(match);
+
+                        if (m_equal(GetKey()(m_slots[index]), key))
+                        {
+                            return index;
+                        }
+                    }
+
+                    if (g.MatchEmpty() != 0 || step > mask)
+                    {
+                        return m_capacity;
+                    }
+
+                    //Triangular numbers visit all the groups if their count is a power of two.
+                    group = (group + step) & mask;
+                }
+            }
+
+            size_t FindFree(size_t h) const
+            {
+                const size_t mask = GroupMask();
+
+                size_t group = (h >> 7) & mask;
+
+                for (size_t step = 1; ; ++step)
+                {
+                    const size_t base = group * Group::width;
+
+                    const uint64_t free = Group(m_ctrl + base).MatchEmptyOrDeleted();
+
+                    if (free != 0)
+                    {
+                        return base + Group::LowestIndex(free);
+                    }
+
+                    group = (group + step) & mask;
+                }
+            }
+
+            //The key is known to be absent.
+            template <class... Args>
+            size_t InsertUnique(size_t h, Args&&... args)
+            {
+                size_t index;
+
+                if (m_growthLeft == 0)
+                {
+                    //If the most of the occupied slots are deleted, they are dropped without growing the table.
+                    Rehash(m_capacity != 0 && m_size < MaxLoad(m_capacity) / 2 ? m_capacity : CapacityFor(m_size + 1));
+
+                    index = FindFree(h);
+
+                    //There are no deleted slots after the rehash.
+                    --m_growthLeft;
+                }
+                else
+                {
+                    index = FindFree(h);
+
+                    //Reusing a deleted slot does not consume the growth.
+                    if (m_ctrl[index] == Group::emptyByte)
+                    {
+                        --m_growthLeft;
+                    }
+                }
+
+                SlotAllocatorTraits::construct(m_slotAlloc, m_slots + index, std::forward<Args>(args)...);
+
+                m_ctrl[index] = static_cast<int8_t>(H2(h));
+
+                ++m_size;
+
+                return index;
+            }
+
+            void EraseIndex(size_t index)
+            {
+                SlotAllocatorTraits::destroy(m_slotAlloc, m_slots + index);
+
+                --m_size;
+
+                //If the group has an empty slot, no probe sequence goes through it, so the slot can become empty.
+                const size_t base = index / Group::width * Group::width;
+
+                if (Group(m_ctrl + base).MatchEmpty() != 0)
+                {
+                    m_ctrl[index] = Group::emptyByte;
+
+                    ++m_growthLeft;
+                }
+                else
+                {
+                    m_ctrl[index] = Group::deletedByte;
+                }
+            }
+
+            void Rehash(size_t capacity)
+            {
+                assert(capacity >= CapacityFor(m_size));
+
+                int8_t* old_ctrl = m_ctrl;
+                Value* old_slots = m_slots;
+                const size_t old_capacity = m_capacity;
+
+                m_ctrl = m_ctrlAlloc.allocate(capacity);
+
+                try
+                {
+                    m_slots = SlotAllocatorTraits::allocate(m_slotAlloc, capacity);
+                }
+                catch (...)
+                {
+                    m_ctrlAlloc.deallocate(m_ctrl, capacity);
+                    m_ctrl = old_ctrl;
+                    throw;
+                }
+
+                std::fill(m_ctrl, m_ctrl + capacity, Group::emptyByte);
+
+                m_capacity = capacity;
+                m_growthLeft = MaxLoad(capacity) - m_size;
+
+                for (size_t i = 0; i < old_capacity; ++i)
+                {
+                    if (old_ctrl[i] >= 0)
+                    {
+                        Value& val = old_slots[i];
+
+                        const size_t h = HashOf(GetKey()(val));
+
+                        const size_t index = FindFree(h);
+
+                        SlotAllocatorTraits::construct(m_slotAlloc, m_slots + index, std::move_if_noexcept(val));
+
+                        m_ctrl[index] = static_cast<int8_t>(H2(h));
+
+                        SlotAllocatorTraits::destroy(m_slotAlloc, old_slots + i);
+                    }
+                }
+
+                if (old_capacity != 0)
+                {
+                    m_ctrlAlloc.deallocate(old_ctrl, old_capacity);
+                    SlotAllocatorTraits::deallocate(m_slotAlloc, old_slots, old_capacity);
+                }
+            }
+
+            void DestroySlots()
+            {
+                if constexpr (!std::is_trivially_destructible_v<Value>)
+                {
+                    for (size_t i = 0; i < m_capacity; ++i)
+                    {
+                        if (m_ctrl[i] >= 0)
+                        {
+                            SlotAllocatorTraits::destroy(m_slotAlloc, m_slots + i);
+                        }
+                    }
+                }
+            }
+
+            void Destroy()
+            {
+                if (m_capacity != 0)
+                {
+                    DestroySlots();
+
+                    m_ctrlAlloc.deallocate(m_ctrl, m_capacity);
+                    SlotAllocatorTraits::deallocate(m_slotAlloc, m_slots, m_capacity);
+
+                    m_ctrl = nullptr;
+                    m_slots = nullptr;
+                    m_capacity = 0;
+                    m_size = 0;
+                    m_growthLeft = 0;
+                }
+            }
+
+            void Steal(FlatHashTable& other)
+            {
+                m_ctrl = std::exchange(other.m_ctrl, nullptr);
+                m_slots = std::exchange(other.m_slots, nullptr);
+                m_capacity = std::exchange(other.m_capacity, 0);
+                m_size = std::exchange(other.m_size, 0);
+                m_growthLeft = std::exchange(other.m_growthLeft, 0);
+            }
+
+            Hash m_hash;
+
+            KeyEqual m_equal;
+
+            SlotAllocator m_slotAlloc;
+
+            CtrlAllocator m_ctrlAlloc;
+
+            int8_t* m_ctrl = nullptr;
+
+            Value* m_slots = nullptr;
+
+            size_t m_capacity = 0;
+
+            size_t m_size = 0;
+
+            size_t m_growthLeft = 0;
+        };
+    }
+
+    template <class T, class Hash = awl::hash<T>, class KeyEqual = std::equal_to<T>, class Allocator = std::allocator<T>>
+    class flat_hash_set : public helpers::FlatHashTable<T, T, helpers::SetKeyGetter<T>, Hash, KeyEqual, Allocator>
+    {
+    private:
+
+        using Base = helpers::FlatHashTable<T, T, helpers::SetKeyGetter<T>, Hash, KeyEqual, Allocator>;
+
+    public:
+
+        using Base::Base;
+
+        flat_hash_set() = default;
+
+        flat_hash_set(std::initializer_list<T> init) : Base(init)
+        {
+        }
+    };
+
+    template <class Key, class T, class Hash = awl::hash<Key>, class KeyEqual = std::equal_to<Key>,
+        class Allocator = std::allocator<std::pair<const Key, T>>>
+    class flat_hash_map : public helpers::FlatHashTable<std::pair<const Key, T>, Key,
+        helpers::MapKeyGetter<std::pair<const Key, T>>, Hash, KeyEqual, Allocator>
+    {
+    private:
+
+        using Base = helpers::FlatHashTable<std::pair<const Key, T>, Key,
+            helpers::MapKeyGetter<std::pair<const Key, T>>, Hash, KeyEqual, Allocator>;
+
+    public:
+
+        using mapped_type = T;
+
+        using typename Base::value_type;
+        using typename Base::iterator;
+        using typename Base::const_iterator;
+
+        using Base::Base;
+        using Base::insert;
+
+        flat_hash_map() = default;
+
+        flat_hash_map(std::initializer_list<value_type> init) : Base(init)
+        {
+        }
+
+        //Does not construct the value if the key exists.
+        template <class... Args>
+        std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+        {
+            return this->InsertImpl(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+
+        template <class... Args>
+        std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args)
+        {
+            return this->InsertImpl(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+
+        template <class M>
+        std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj)
+        {
+            auto result = try_emplace(key, std::forward<M>(obj));
+
+            if (!result.second)
+            {
+                result.first->second = std::forward<M>(obj);
+            }
+
+            return result;
+        }
+
+        T& operator[](const Key& key)
+        {
+            return try_emplace(key).first->second;
+        }
+
+        T& operator[](Key&& key)
+        {
+            return try_emplace(std::move(key)).first->second;
+        }
+
+        template <class K>
+        T& at(const K& key)
+        {
+            auto i = this->find(key);
+
+            if (i == this->end())
+            {
+                throw std::out_of_range("Key not found.");
+            }
+
+            return i->second;
+        }
+
+        template <class K>
+        const T& at(const K& key) const
+        {
+            auto i = this->find(key);
+
+            if (i == this->end())
+            {
+                throw std::out_of_range("Key not found.");
+            }
+
+            return i->second;
+        }
+    };
+}
@@ -6,8 +6,12 @@
 #pragma once
 
 #include "Awl/Tuplizable.h"
+#include "Awl/TupleHelpers.h"
+#include "Awl/Crypto/FastHash.h"
 
 #include <functional>
+#include <ranges>
+#include <cstring>
 
 namespace awl
 {
@@ -43,6 +47,92 @@ namespace awl
         HashValueImpl<std::tuple<Ts...>>::apply(seed, t);
         return seed;
     }
+
+    //Hashes tuplizable types by their members and other types with std::hash.
+    template <class T>
+    struct hash
+    {
+        size_t operator()(const T& val) const
+        {
+            if constexpr (is_tuplizable_v<T>)
+            {
+                return GetTupleHash(object_as_const_tuple(val));
+            }
+            else
+            {
+                return std::hash<T>()(val);
+            }
+        }
+    };
+
+    //Chains the hash of the value with the seed, so the order of the members matters.
+    //Contiguous ranges of arithmetic types, strings for example, are hashed by their bytes.
+    template <class T>
+    uint64_t FastHashValue(uint64_t seed, const T& val)
+    {
+        using crypto::FastHashFunctions;
+
+        constexpr uint64_t seedKey = UINT64_C(0x9E3779B97F4A7C15);
+        constexpr uint64_t valueKey = UINT64_C(0xD6E8FEB86659FD93);
+
+        if constexpr (is_tuplizable_v<T>)
+        {
+            for_each(object_as_const_tuple(val), [&seed](const auto& member)
+            {
+                seed = FastHashValue(seed, member);
+            });
+
+            return seed;
+        }
+        else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+        {
+            return FastHashFunctions::Mix(seed ^ seedKey, static_cast<uint64_t>(val) ^ valueKey);
+        }
+        else if constexpr (std::is_floating_point_v<T> && sizeof(T) <= sizeof(uint64_t))
+        {
+            uint64_t bits = 0;
+
+            //Positive and negative zeros are equal.
+            if (val != 0)
+            {
+                std::memcpy(&bits, &val, sizeof(T));
+            }
+
+            return FastHashFunctions::Mix(seed ^ seedKey, bits ^ valueKey);
+        }
+        else if constexpr (std::ranges::contiguous_range<const T> && std::is_arithmetic_v<std::ranges::range_value_t<const T>>)
+        {
+            return FastHashFunctions::Hash64(reinterpret_cast<const uint8_t*>(std::ranges::data(val)),
+                std::ranges::size(val) * sizeof(std::ranges::range_value_t<const T>), seed);
+        }
+        else if constexpr (std::ranges::input_range<const T>)
+        {
+            uint64_t count = 0;
+
+            for (const auto& element : val)
+            {
+                seed = FastHashValue(seed, element);
+
+                ++count;
+            }
+
+            return FastHashValue(seed, count);
+        }
+        else
+        {
+            return FastHashFunctions::Mix(seed ^ seedKey, static_cast<uint64_t>(std::hash<T>()(val)) ^ valueKey);
+        }
+    }
+
+    //A higher quality alternative to awl::hash, every member goes through a 128 bit multiplication.
+    template <class T>
+    struct fast_hash
+    {
+        size_t operator()(const T& val) const
+        {
+            return static_cast<size_t>(FastHashValue(0, val));
+        }
+    };
 }
 
 namespace std
@@ -0,0 +1,706 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <stdexcept>
+#include <cassert>
+#include <iterator>
+#include <algorithm>
+#include <vector>
+#include <span>
+#include <ranges>
+#include <limits>
+#include <optional>
+#include <functional>
+#include <map>
+#include <type_traits>
+
+namespace awl
+{
+    //Maps closed integral intervals [left, right] to values. The intervals are stored in a sorted vector,
+    //they do not overlap and adjacent intervals with equal values are always merged.
+    template<
+        class Key,
+        class T,
+        class Compare = std::less<Key>,
+        class Allocator = std::allocator<std::pair<const Key, T>>
+    >
+    class interval_map
+    {
+    public:
+
+        static_assert(std::is_integral_v<Key>, "interval_map requires an integral key.");
+
+        struct interval_type
+        {
+            Key left;
+            Key right;
+            T value;
+        };
+
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<const Key, T>;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using key_compare = Compare;
+
+    private:
+
+        using IntervalAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<interval_type>;
+
+        using IntervalVector = std::vector<interval_type, IntervalAllocator>;
+
+        //Iterates over the keys, the intervals are expanded.
+        template <class Container, class Value>
+        class MyIterator
+        {
+        public:
+
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = std::pair<const Key, Value&>;
+            using difference_type = std::ptrdiff_t;
+            using reference = value_type;
+            using pointer = void;
+
+            MyIterator() = default;
+
+            MyIterator(const MyIterator& other) = default;
+            MyIterator(MyIterator&& other) = default;
+
+            MyIterator& operator = (const MyIterator& other) = default;
+            MyIterator& operator = (MyIterator&& other) = default;
+
+            value_type operator* () const
+            {
+                return value_type{ m_key, interval().value };
+            }
+
+            MyIterator& operator++ ()
+            {
+                move_next();
+
+                return *this;
+            }
+
+            MyIterator operator++ (int)
+            {
+                MyIterator tmp = *this;
+
+                move_next();
+
+                return tmp;
+            }
+
+            MyIterator& operator-- ()
+            {
+                move_prev();
+
+                return *this;
+            }
+
+            MyIterator operator-- (int)
+            {
+                MyIterator tmp = *this;
+
+                move_prev();
+
+                return tmp;
+            }
+
+            bool operator == (const MyIterator& other) const
+            {
+                assert(m_pMap == other.m_pMap);
+
+                return m_index == other.m_index && m_key == other.m_key;
+            }
+
+            bool operator != (const MyIterator& other) const
+            {
+                return !(*this == other);
+            }
+
+            // Conversion to const_iterator
+            operator MyIterator<const Container, const Value>() const
+            {
+                return MyIterator<const Container, const Value>(m_pMap, m_index, m_key);
+            }
+
+        private:
+
+            MyIterator(Container* p_map, size_t index, Key key) :
+                m_pMap(p_map), m_index(index), m_key(key)
+            {
+            }
+
+            auto& interval() const
+            {
+                return m_pMap->m_v[m_index];
+            }
+
+            void move_next()
+            {
+                assert(m_index < m_pMap->m_v.size());
+
+                if (m_key == interval().right)
+                {
+                    ++m_index;
+
+                    m_key = m_index != m_pMap->m_v.size() ? interval().left : Key{};
+                }
+                else
+                {
+                    ++m_key;
+                }
+            }
+
+            void move_prev()
+            {
+                if (m_index == m_pMap->m_v.size() || m_key == interval().left)
+                {
+                    assert(m_index != 0);
+
+                    --m_index;
+
+                    m_key = interval().right;
+                }
+                else
+                {
+                    --m_key;
+                }
+            }
+
+            Container* m_pMap = nullptr;
+
+            size_t m_index = 0;
+
+            Key m_key{};
+
+            friend interval_map;
+        };
+
+    public:
+
+        using iterator = MyIterator<interval_map, T>;
+        using const_iterator = MyIterator<const interval_map, const T>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        using interval_iterator = typename IntervalVector::const_iterator;
+
+        interval_map() = default;
+
+        explicit interval_map(const Compare& comp, const Allocator& alloc = Allocator()) :
+            m_comp(comp), m_v(IntervalAllocator(alloc))
+        {
+        }
+
+        interval_map(const interval_map&) = default;
+        interval_map(interval_map&&) = default;
+
+        interval_map& operator = (const interval_map&) = default;
+        interval_map& operator = (interval_map&&) = default;
+
+        iterator begin() { return make_begin(this); }
+        const_iterator begin() const { return cbegin(); }
+        const_iterator cbegin() const { return make_begin(this); }
+
+        iterator end() { return iterator(this, m_v.size(), Key{}); }
+        const_iterator end() const { return cend(); }
+        const_iterator cend() const { return const_iterator(this, m_v.size(), Key{}); }
+
+        reverse_iterator rbegin() { return std::make_reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const { return crbegin(); }
+        const_reverse_iterator crbegin() const { return std::make_reverse_iterator(cend()); }
+
+        reverse_iterator rend() { return std::make_reverse_iterator(begin()); }
+        const_reverse_iterator rend() const { return crend(); }
+        const_reverse_iterator crend() const { return std::make_reverse_iterator(cbegin()); }
+
+        //The intervals in ascending order.
+        std::span<const interval_type> intervals() const
+        {
+            return m_v;
+        }
+
+        size_type interval_count() const
+        {
+            return m_v.size();
+        }
+
+        bool empty() const
+        {
+            return m_v.empty();
+        }
+
+        void reserve(size_type count)
+        {
+            m_v.reserve(count);
+        }
+
+        key_compare key_comp() const
+        {
+            return m_comp;
+        }
+
+        //Stabbing query, returns the interval containing the key or interval_end().
+        interval_iterator find(const Key& key) const
+        {
+            auto i = find_right(key);
+
+            if (i != m_v.end() && less_or_equal(i->left, key))
+            {
+                return i;
+            }
+
+            return m_v.end();
+        }
+
+        interval_iterator interval_begin() const
+        {
+            return m_v.begin();
+        }
+
+        interval_iterator interval_end() const
+        {
+            return m_v.end();
+        }
+
+        //The intervals that intersect [a, b].
+        std::ranges::subrange<interval_iterator> overlapping(const Key& a, const Key& b) const
+        {
+            auto first = find_right(a);
+
+            auto last = std::partition_point(first, m_v.cend(),
+                [this, &b](const interval_type& v) { return less_or_equal(v.left, b); });
+
+            return { first, last };
+        }
+
+        bool contains(const Key& key) const
+        {
+            return find(key) != m_v.end();
+        }
+
+        const T& at(const Key& key) const
+        {
+            auto i = find(key);
+
+            if (i == m_v.end())
+            {
+                throw std::out_of_range("Specified key does not exist.");
+            }
+
+            return i->value;
+        }
+
+        //Modifying the value does not merge the interval with its neighbors.
+        T& at(const Key& key)
+        {
+            // The object itself is non-const, and casting away the const is allowed.
+            return const_cast<T&>(const_cast<const interval_map*>(this)->at(key));
+        }
+
+        template <class U>
+        void assign(const Key& a, const Key& b, U&& value)
+        {
+            if (greater(a, b))
+            {
+                return;
+            }
+
+            auto first = m_v.begin() + (find_right(a) - m_v.cbegin());
+
+            auto last = std::partition_point(first, m_v.end(),
+                [this, &b](const interval_type& v) { return less_or_equal(v.left, b); });
+
+            //[first, last) intersect [a, b], the parts of them outside [a, b] become the head and the tail.
+            interval_type middle{ a, b, std::forward<U>(value) };
+
+            std::optional<interval_type> head;
+            std::optional<interval_type> tail;
+
+            if (first != last)
+            {
+                interval_type& front = *first;
+                interval_type& back = *std::prev(last);
+
+                if (less(front.left, a) && !(front.value == middle.value))
+                {
+                    //Split a single interval into two parts.
+                    head = interval_type{ front.left, previous_key(a), &front == &back ? front.value : std::move(front.value) };
+                }
+                else
+                {
+                    middle.left = std::min(front.left, a, m_comp);
+                }
+
+                if (greater(back.right, b) && !(back.value == middle.value))
+                {
+                    tail = interval_type{ next_key(b), back.right, std::move(back.value) };
+                }
+                else
+                {
+                    middle.right = std::max(back.right, b, m_comp);
+                }
+            }
+
+            // Merge adjacent intervals with the same value.
+            if (first != m_v.begin() && adjacent(*std::prev(first), middle) && std::prev(first)->value == middle.value)
+            {
+                --first;
+
+                middle.left = first->left;
+            }
+
+            if (last != m_v.end() && adjacent(middle, *last) && last->value == middle.value)
+            {
+                middle.right = last->right;
+
+                ++last;
+            }
+
+            Replace(first, last, std::move(head), std::move(middle), std::move(tail));
+        }
+
+        //Equivalent to assigning the intervals one by one, but the existing intervals are merged
+        //with the new ones in a single pass.
+        template <std::ranges::input_range Range>
+            requires std::is_convertible_v<std::ranges::range_reference_t<Range>, const interval_type&>
+        void assign(Range&& range)
+        {
+            if constexpr (std::ranges::forward_range<Range>)
+            {
+                if (is_ordered(range))
+                {
+                    MergeOrdered(range);
+
+                    return;
+                }
+
+                if constexpr (std::is_lvalue_reference_v<std::ranges::range_reference_t<Range>>)
+                {
+                    MergeUnordered(range);
+
+                    return;
+                }
+            }
+
+            for (const interval_type& v : range)
+            {
+                assign(v.left, v.right, v.value);
+            }
+        }
+
+        void clear()
+        {
+            m_v.clear();
+        }
+
+        bool operator == (const interval_map& other) const
+        {
+            return std::ranges::equal(m_v, other.m_v, [](const interval_type& a, const interval_type& b)
+            {
+                return a.left == b.left && a.right == b.right && a.value == b.value;
+            });
+        }
+
+        bool operator != (const interval_map& other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+
+        template <class Container>
+        static auto make_begin(Container* p_map)
+        {
+            using Iterator = std::conditional_t<std::is_const_v<Container>, const_iterator, iterator>;
+
+            return p_map->m_v.empty() ? Iterator(p_map, 0, Key{}) : Iterator(p_map, 0, p_map->m_v.front().left);
+        }
+
+        //Replaces [first, last) with the specified intervals, the rest of the vector is moved once in most cases.
+        void Replace(typename IntervalVector::iterator first, typename IntervalVector::iterator last,
+            std::optional<interval_type> head, interval_type middle, std::optional<interval_type> tail)
+        {
+            const size_t new_count = 1 + (head ? 1 : 0) + (tail ? 1 : 0);
+            const size_t old_count = static_cast<size_t>(last - first);
+
+            if (old_count > new_count)
+            {
+                last = m_v.erase(first + new_count, last);
+
+                first = last - new_count;
+            }
+
+            auto put = [this, &first, &last](interval_type&& v)
+            {
+                if (first == last)
+                {
+                    last = m_v.insert(first, std::move(v)) + 1;
+
+                    first = last;
+                }
+                else
+                {
+                    *first++ = std::move(v);
+                }
+            };
+
+            if (head)
+            {
+                put(std::move(*head));
+            }
+
+            put(std::move(middle));
+
+            if (tail)
+            {
+                put(std::move(*tail));
+            }
+        }
+
+        template <class Range>
+        bool is_ordered(Range& range) const
+        {
+            bool first = true;
+
+            Key prev_right{};
+
+            for (const interval_type& v : range)
+            {
+                if (greater(v.left, v.right) || (!first && !less(prev_right, v.left)))
+                {
+                    return false;
+                }
+
+                first = false;
+
+                prev_right = v.right;
+            }
+
+            return true;
+        }
+
+        template <class Range>
+        void MergeOrdered(Range& range)
+        {
+            IntervalVector old = std::move(m_v);
+
+            m_v = IntervalVector(old.get_allocator());
+
+            if constexpr (std::ranges::sized_range<Range>)
+            {
+                m_v.reserve(old.size() + std::ranges::size(range) * 2);
+            }
+
+            size_t i = 0;
+
+            for (const auto& v : range)
+            {
+                while (i < old.size() && less(old[i].right, v.left))
+                {
+                    Append(std::move(old[i++]));
+                }
+
+                if (i < old.size() && less(old[i].left, v.left))
+                {
+                    if (less(v.right, old[i].right))
+                    {
+                        //v is inside the interval, its tail remains in old.
+                        Append(interval_type{ old[i].left, previous_key(v.left), old[i].value });
+
+                        old[i].left = next_key(v.right);
+                    }
+                    else
+                    {
+                        old[i].right = previous_key(v.left);
+
+                        Append(std::move(old[i++]));
+                    }
+                }
+
+                while (i < old.size() && less_or_equal(old[i].right, v.right))
+                {
+                    ++i;
+                }
+
+                if (i < old.size() && less_or_equal(old[i].left, v.right))
+                {
+                    old[i].left = next_key(v.right);
+                }
+
+                Append(interval_type{ v.left, v.right, static_cast<const T&>(v.value) });
+            }
+
+            while (i < old.size())
+            {
+                Append(std::move(old[i++]));
+            }
+        }
+
+        //Paints the intervals in the reverse order, so the pieces that are overwritten by the later intervals
+        //are skipped, and merges the remaining sorted pieces.
+        template <class Range>
+        void MergeUnordered(Range& range)
+        {
+            struct Piece
+            {
+                Key left;
+                Key right;
+                std::reference_wrapper<const T> value;
+            };
+
+            std::vector<const interval_type*> source;
+
+            for (const interval_type& v : range)
+            {
+                source.push_back(&v);
+            }
+
+            std::vector<Piece> pieces;
+
+            //Left keys to right keys of the painted intervals.
+            std::map<Key, Key, Compare> painted(m_comp);
+
+            for (auto i = source.rbegin(); i != source.rend(); ++i)
+            {
+                const interval_type& v = **i;
+
+                if (greater(v.left, v.right))
+                {
+                    continue;
+                }
+
+                Key left = v.left;
+                Key right = v.right;
+
+                auto j = painted.upper_bound(v.left);
+
+                if (j != painted.begin() && less_or_equal(v.left, std::prev(j)->second))
+                {
+                    --j;
+                }
+
+                Key cursor = v.left;
+
+                bool covered = false;
+
+                while (j != painted.end() && less_or_equal(j->first, v.right))
+                {
+                    if (less(cursor, j->first))
+                    {
+                        pieces.push_back(Piece{ cursor, previous_key(j->first), v.value });
+                    }
+
+                    left = std::min(left, j->first, m_comp);
+                    right = std::max(right, j->second, m_comp);
+
+                    covered = !less(j->second, v.right);
+
+                    if (!covered)
+                    {
+                        cursor = next_key(j->second);
+                    }
+
+                    j = painted.erase(j);
+
+                    if (covered)
+                    {
+                        break;
+                    }
+                }
+
+                if (!covered)
+                {
+                    pieces.push_back(Piece{ cursor, v.right, v.value });
+                }
+
+                painted.emplace_hint(j, left, right);
+            }
+
+            std::ranges::sort(pieces, m_comp, &Piece::left);
+
+            MergeOrdered(pieces);
+        }
+
+        template <class Interval>
+        void Append(Interval&& v)
+        {
+            if (!m_v.empty())
+            {
+                interval_type& back = m_v.back();
+
+                if (adjacent(back, v) && back.value == v.value)
+                {
+                    back.right = v.right;
+
+                    return;
+                }
+            }
+
+            m_v.push_back(std::forward<Interval>(v));
+        }
+
+        //Returns the first interval that does not end before the key.
+        interval_iterator find_right(const Key& key) const
+        {
+            return std::partition_point(m_v.begin(), m_v.end(),
+                [this, &key](const interval_type& v) { return less(v.right, key); });
+        }
+
+        bool adjacent(const interval_type& a, const interval_type& b) const
+        {
+            return a.right != std::numeric_limits<Key>::max() && equal(next_key(a.right), b.left);
+        }
+
+        bool less(const Key& left, const Key& right) const
+        {
+            return m_comp(left, right);
+        }
+
+        bool greater(const Key& left, const Key& right) const
+        {
+            return less(right, left);
+        }
+
+        bool equal(const Key& left, const Key& right) const
+        {
+            return !less(left, right) && !greater(left, right);
+        }
+
+        bool less_or_equal(const Key& left, const Key& right) const
+        {
+            return !greater(left, right);
+        }
+
+        static Key next_key(const Key& key)
+        {
+            if (key == std::numeric_limits<Key>::max())
+            {
+                throw std::runtime_error("+1 overflow");
+            }
+
+            return key + 1;
+        }
+
+        static Key previous_key(const Key& key)
+        {
+            if (key == std::numeric_limits<Key>::min())
+            {
+                throw std::runtime_error("-1 overflow");
+            }
+
+            return key - 1;
+        }
+
+        Compare m_comp;
+
+        IntervalVector m_v;
+    };
+}
@@ -0,0 +1,521 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Awl/Io/IoException.h"
+#include "Awl/Io/SequentialStream.h"
+#include "Awl/Io/HashStream.h"
+
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <cassert>
+
+namespace awl::io
+{
+    //A byte oriented LZ77 codec in the LZ4 family. The compressed block is a sequence of tokens,
+    //a token is followed by the literals and the offset of the match:
+    //
+    //    token: the literal count in the high nibble, the match length minus minMatch in the low nibble,
+    //           15 means the value continues in the next bytes, each of them is added until a byte is not 255;
+    //    the literals;
+    //    the match offset: two bytes in the little-endian order.
+    //
+    //The last token has only the literals. The decoder knows the decompressed size
+    //and checks all the offsets and lengths, so corrupted data can't make it go out of the buffers.
+    class LzCodec
+    {
+    public:
+
+        static constexpr size_t MaxCompressedSize(size_t size)
+        {
+            return size + size / 255 + 16;
+        }
+
+        //Returns the compressed size, dst should have MaxCompressedSize(size) bytes.
+        static size_t Compress(const uint8_t* src, size_t size, uint8_t* dst)
+        {
+            uint8_t* op = dst;
+
+            size_t anchor = 0;
+
+            if (size >= minInputSize)
+            {
+                std::array<uint32_t, hashTableSize> table{};
+
+                //The last match ends before the last bytes, so a match can be read with 4 byte loads.
+                const size_t match_limit = size - lastLiterals;
+
+                size_t ip = 1;
+
+                while (ip + minMatch <= match_limit)
+                {
+                    const uint32_t seq = Load32(src + ip);
+
+                    const size_t h = Hash(seq);
+
+                    const size_t ref = table[h];
+
+                    table[h] = static_cast<uint32_t>(ip);
+
+                    if (ref >= ip || ip - ref > maxOffset || Load32(src + ref) != seq)
+                    {
+                        //Skip the incompressible data faster.
+                        ip += 1 + ((ip - anchor) >> skipShift);
+
+                        continue;
+                    }
+
+                    size_t match = ip;
+                    size_t match_ref = ref;
+
+                    //Extend the match backwards.
+                    while (match > anchor && match_ref > 0 && src[match - 1] == src[match_ref - 1])
+                    {
+                        --match;
+                        --match_ref;
+                    }
+
+                    size_t length = ip - match + minMatch;
+
+                    while (match + length < match_limit && src[match + length] == src[match_ref + length])
+                    {
+                        ++length;
+                    }
+
+                    op = WriteSequence(op, src + anchor, match - anchor, match - match_ref, length);
+
+                    ip = match + length;
+
+                    anchor = ip;
+
+                    //A position inside the match improves the next search.
+                    table[Hash(Load32(src + ip - 2))] = static_cast<uint32_t>(ip - 2);
+                }
+            }
+
+            //The last literals.
+            const size_t literal_count = size - anchor;
+
+            op = WriteLength(op, literal_count, 4);
+
+            if (literal_count != 0)
+            {
+                std::memcpy(op, src + anchor, literal_count);
+
+                op += literal_count;
+            }
+
+            return static_cast<size_t>(op - dst);
+        }
+
+        //Throws CorruptionException if the data is not a valid compressed block of dst_size bytes.
+        static void Decompress(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size)
+        {
+            const uint8_t* ip = src;
+            const uint8_t* const ip_end = src + src_size;
+
+            uint8_t* op = dst;
+            uint8_t* const op_end = dst + dst_size;
+
+            while (true)
+            {
+                if (ip == ip_end)
+                {
+                    throw CorruptionException();
+                }
+
+                const uint8_t token = *ip++;
+
+                const size_t literal_count = ReadLength(ip, ip_end, token >> 4);
+
+                if (literal_count > static_cast<size_t>(ip_end - ip) || literal_count > static_cast<size_t>(op_end - op))
+                {
+                    throw CorruptionException();
+                }
+
+                if (literal_count != 0)
+                {
+                    std::memcpy(op, ip, literal_count);
+
+                    ip += literal_count;
+                    op += literal_count;
+                }
+
+                if (op == op_end)
+                {
+                    //The last token.
+                    if (ip != ip_end)
+                    {
+                        throw CorruptionException();
+                    }
+
+                    break;
+                }
+
+                if (ip_end - ip < 2)
+                {
+                    throw CorruptionException();
+                }
+
+                const size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+
+                ip += 2;
+
+                const size_t length = ReadLength(ip, ip_end, token & 15) + minMatch;
+
+                if (offset == 0 || offset > static_cast<size_t>(op - dst) || length > static_cast<size_t>(op_end - op))
+                {
+                    throw CorruptionException();
+                }
+
+                const uint8_t* ref = op - offset;
+
+                if (offset >= length)
+                {
+                    std::memcpy(op, ref, length);
+
+                    op += length;
+                }
+                else
+                {
+                    //The match overlaps the output, so the bytes are repeated.
+                    for (uint8_t* end = op + length; op != end; ++op, ++ref)
+                    {
+                        *op = *ref;
+                    }
+                }
+            }
+        }
+
+    private:
+
+        static constexpr size_t minMatch = 4;
+
+        static constexpr size_t maxOffset = 65535;
+
+        static constexpr size_t lastLiterals = 5;
+
+        static constexpr size_t minInputSize = 13;
+
+        static constexpr size_t hashLog = 12;
+
+        static constexpr size_t hashTableSize = size_t(1) << hashLog;
+
+        static constexpr size_t skipShift = 6;
+
+        static uint32_t Load32(const uint8_t* p)
+        {
+            uint32_t val;
+
+            std::memcpy(&val, p, sizeof(val));
+
+            return val;
+        }
+
+        static size_t Hash(uint32_t seq)
+        {
+            return (seq * UINT32_C(2654435761)) >> (32 - hashLog);
+        }
+
+        //Writes the token with the length in the nibble selected by shift and the extra length bytes.
+        static uint8_t* WriteLength(uint8_t* op, size_t length, unsigned shift)
+        {
+            if (length < 15)
+            {
+                *op++ = static_cast<uint8_t>(length << shift);
+
+                return op;
+            }
+
+            *op++ = static_cast<uint8_t>(15u << shift);
+
+            return WriteExtraLength(op, length - 15);
+        }
+
+        static uint8_t* WriteExtraLength(uint8_t* op, size_t length)
+        {
+            for (; length >= 255; length -= 255)
+            {
+                *op++ = 255;
+            }
+
+            *op++ = static_cast<uint8_t>(length);
+
+            return op;
+        }
+
+        static uint8_t* WriteSequence(uint8_t* op, const uint8_t* literals, size_t literal_count, size_t offset, size_t length)
+        {
+            uint8_t* token = op++;
+
+            *token = static_cast<uint8_t>(std::min<size_t>(literal_count, 15) << 4);
+
+            if (literal_count >= 15)
+            {
+                op = WriteExtraLength(op, literal_count - 15);
+            }
+
+            if (literal_count != 0)
+            {
+                std::memcpy(op, literals, literal_count);
+
+                op += literal_count;
+            }
+
+            *op++ = static_cast<uint8_t>(offset);
+            *op++ = static_cast<uint8_t>(offset >> 8);
+
+            const size_t extra_length = length - minMatch;
+
+            *token |= static_cast<uint8_t>(std::min<size_t>(extra_length, 15));
+
+            if (extra_length >= 15)
+            {
+                op = WriteExtraLength(op, extra_length - 15);
+            }
+
+            return op;
+        }
+
+        static size_t ReadLength(const uint8_t*& ip, const uint8_t* ip_end, size_t length)
+        {
+            if (length == 15)
+            {
+                uint8_t b;
+
+                do
+                {
+                    if (ip == ip_end)
+                    {
+                        throw CorruptionException();
+                    }
+
+                    b = *ip++;
+
+                    length += b;
+                }
+                while (b == 255);
+            }
+
+            return length;
+        }
+    };
+
+    //A compressed block is preceded by its decompressed and stored sizes, if they are equal, the block is stored
+    //without compression. The blocks are independent, so Flush() can be called at any time, and the streams
+    //can be stacked with HashOutputStream and HashInputStream.
+
+    struct CompressedBlockHeader
+    {
+        uint32_t rawSize;
+
+        uint32_t storedSize;
+    };
+
+    template <class UnderlyingStream = SequentialOutputStream>
+    class CompressedOutputStream : public SequentialOutputStream
+    {
+    public:
+
+        CompressedOutputStream(UnderlyingStream& out, size_t block_size = defaultBlockSize) :
+            m_out(out),
+            blockSize(block_size)
+        {
+            assert(blockSize != 0 && blockSize <= UINT32_MAX);
+
+            m_block.reserve(blockSize);
+        }
+
+        ~CompressedOutputStream()
+        {
+            Flush();
+        }
+
+        void Write(const uint8_t* buffer, size_t count) override
+        {
+            while (count != 0)
+            {
+                const size_t insert_count = std::min(blockSize - m_block.size(), count);
+
+                m_block.insert(m_block.end(), buffer, buffer + insert_count);
+
+                if (m_block.size() == blockSize)
+                {
+                    Flush();
+                }
+
+                buffer += insert_count;
+                count -= insert_count;
+            }
+        }
+
+        //Compresses and writes the current block.
+        void Flush()
+        {
+            if (m_block.empty())
+            {
+                return;
+            }
+
+            m_compressed.resize(sizeof(CompressedBlockHeader) + LzCodec::MaxCompressedSize(m_block.size()));
+
+            uint8_t* payload = m_compressed.data() + sizeof(CompressedBlockHeader);
+
+            size_t stored_size = LzCodec::Compress(m_block.data(), m_block.size(), payload);
+
+            if (stored_size >= m_block.size())
+            {
+                stored_size = m_block.size();
+
+                std::memcpy(payload, m_block.data(), stored_size);
+            }
+
+            const CompressedBlockHeader header = { static_cast<uint32_t>(m_block.size()), static_cast<uint32_t>(stored_size) };
+
+            std::memcpy(m_compressed.data(), &header, sizeof(header));
+
+            m_out.Write(m_compressed.data(), sizeof(header) + stored_size);
+
+            m_block.clear();
+        }
+
+    private:
+
+        UnderlyingStream& m_out;
+
+        const size_t blockSize;
+
+        std::vector<uint8_t> m_block;
+
+        std::vector<uint8_t> m_compressed;
+    };
+
+    template <class UnderlyingStream = SequentialInputStream>
+    class CompressedInputStream : public SequentialInputStream
+    {
+    public:
+
+        //Lends the bytes of its current block.
+        static constexpr bool lendsMemory = true;
+
+        //block_size is the maximum decompressed size of a block, a larger block is considered corrupted.
+        CompressedInputStream(UnderlyingStream& in, size_t block_size = defaultBlockSize) :
+            m_in(in),
+            blockSize(block_size)
+        {
+        }
+
+        bool End() override
+        {
+            return !PeekBuf();
+        }
+
+        size_t Read(uint8_t* buffer, size_t count) override
+        {
+            size_t read_count = 0;
+
+            while (read_count != count && PeekBuf())
+            {
+                const size_t copy_count = std::min(m_block.size() - m_pos, count - read_count);
+
+                std::memcpy(buffer + read_count, m_block.data() + m_pos, copy_count);
+
+                m_pos += copy_count;
+                read_count += copy_count;
+            }
+
+            return read_count;
+        }
+
+        const uint8_t* Borrow(size_t count) override
+        {
+            const uint8_t* p = Peek(count);
+
+            if (p != nullptr)
+            {
+                m_pos += count;
+            }
+
+            return p;
+        }
+
+        //Only the bytes of the current block can be lent.
+        const uint8_t* Peek(size_t count) override
+        {
+            if (!PeekBuf() || count > m_block.size() - m_pos)
+            {
+                return nullptr;
+            }
+
+            return m_block.data() + m_pos;
+        }
+
+    private:
+
+        //Decompresses the next block if the current one is over.
+        //Returns false at the end of the stream.
+        bool PeekBuf()
+        {
+            while (m_pos == m_block.size())
+            {
+                CompressedBlockHeader header;
+
+                const size_t actually_read = m_in.Read(reinterpret_cast<uint8_t*>(&header), sizeof(header));
+
+                if (actually_read == 0)
+                {
+                    return false;
+                }
+
+                if (actually_read != sizeof(header) || header.rawSize == 0 || header.rawSize > blockSize ||
+                    header.storedSize > header.rawSize)
+                {
+                    throw CorruptionException();
+                }
+
+                m_block.resize(header.rawSize);
+
+                m_pos = 0;
+
+                if (header.storedSize == header.rawSize)
+                {
+                    ReadPayload(m_block.data(), header.storedSize);
+                }
+                else
+                {
+                    m_compressed.resize(header.storedSize);
+
+                    ReadPayload(m_compressed.data(), header.storedSize);
+
+                    LzCodec::Decompress(m_compressed.data(), m_compressed.size(), m_block.data(), m_block.size());
+                }
+            }
+
+            return true;
+        }
+
+        void ReadPayload(uint8_t* buffer, size_t count)
+        {
+            if (m_in.Read(buffer, count) != count)
+            {
+                throw CorruptionException();
+            }
+        }
+
+        UnderlyingStream& m_in;
+
+        const size_t blockSize;
+
+        std::vector<uint8_t> m_block;
+
+        std::vector<uint8_t> m_compressed;
+
+        size_t m_pos = 0;
+    };
+}
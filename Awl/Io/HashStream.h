@@ -24,6 +24,9 @@ namespace awl
         {
         public:
 
+            //Lends the bytes of its current block.
+            static constexpr bool lendsMemory = true;
+
             HashInputStream(UnderlyingStream& in, size_t block_size = defaultBlockSize, Hash hash = {}) : m_hash(hash), m_in(in), blockSize(block_size), m_i(m_block.end())
             {
                 assert(blockSize > Hash::size());
@@ -40,6 +43,31 @@ namespace awl
 
             size_t Read(uint8_t * buffer, size_t count) override;
 
+            const uint8_t* Borrow(size_t count) override
+            {
+                const uint8_t* p = Peek(count);
+
+                if (p != nullptr)
+                {
+                    m_i += count;
+                }
+
+                return p;
+            }
+
+            //Only the bytes of the current block can be lent.
+            const uint8_t* Peek(size_t count) override
+            {
+                PeekBuf();
+
+                if (m_i == m_block.end() || count > static_cast<size_t>(m_block.end() - m_i))
+                {
+                    return nullptr;
+                }
+
+                return static_cast<const uint8_t *>(&(*m_i));
+            }
+
         private:
 
             bool InternalEnd()
@@ -82,7 +110,8 @@ namespace awl
                             read_val[i] = *(hash_begin + i);
                         }
 
-                        auto calculated_val = m_hash(m_block.begin(), hash_begin);
+                        //Pointers rather than iterators, so the hashes that accept only pointers also work.
+                        auto calculated_val = m_hash(m_block.data(), m_block.data() + actually_read - Hash::size());
 
                         if (calculated_val != read_val)
                         {
@@ -184,7 +213,7 @@ namespace awl
             {
                 if (!m_v.empty())
                 {
-                    auto val = m_hash(m_v.begin(), m_v.end());
+                    auto val = m_hash(m_v.data(), m_v.data() + m_v.size());
 
                     m_v.insert(m_v.end(), val.begin(), val.end());
 
@@ -0,0 +1,260 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Awl/Io/SequentialStream.h"
+#include "Awl/Io/HashStream.h"
+
+#include <memory>
+#include <cstring>
+#include <cassert>
+
+namespace awl::io
+{
+    //A buffer in front of an underlying stream. The classes are final, so when a Read/Write function
+    //is instantiated with the concrete stream type, the calls are not virtual and a small read or write
+    //is inlined as a bounds check and a memcpy. Only the slow path goes to the underlying stream.
+
+    template <class UnderlyingStream = SequentialOutputStream>
+    class InlineOutputStream final : public SequentialOutputStream
+    {
+    public:
+
+        InlineOutputStream(UnderlyingStream& out, size_t buffer_size = defaultBlockSize) :
+            m_out(out),
+            m_buffer(new uint8_t[buffer_size]),
+            m_cursor(m_buffer.get()),
+            m_end(m_buffer.get() + buffer_size)
+        {
+            assert(buffer_size != 0);
+        }
+
+        InlineOutputStream(const InlineOutputStream&) = delete;
+
+        InlineOutputStream& operator = (const InlineOutputStream&) = delete;
+
+        ~InlineOutputStream()
+        {
+            Flush();
+        }
+
+        void Write(const uint8_t* buffer, size_t count) override
+        {
+            if (count <= static_cast<size_t>(m_end - m_cursor))
+            {
+                //Do not call std::memcpy with zero length to avoid GCC Address Sanitizer warnings.
+                if (count != 0)
+                {
+                    std::memcpy(m_cursor, buffer, count);
+
+                    m_cursor += count;
+                }
+            }
+            else
+            {
+                WriteSlow(buffer, count);
+            }
+        }
+
+        void Flush()
+        {
+            const size_t count = static_cast<size_t>(m_cursor - m_buffer.get());
+
+            if (count != 0)
+            {
+                m_out.Write(m_buffer.get(), count);
+
+                m_cursor = m_buffer.get();
+            }
+        }
+
+    private:
+
+        void WriteSlow(const uint8_t* buffer, size_t count)
+        {
+            Flush();
+
+            const size_t capacity = static_cast<size_t>(m_end - m_buffer.get());
+
+            //A large block goes directly to the underlying stream.
+            if (count >= capacity)
+            {
+                m_out.Write(buffer, count);
+            }
+            else
+            {
+                std::memcpy(m_cursor, buffer, count);
+
+                m_cursor += count;
+            }
+        }
+
+        UnderlyingStream& m_out;
+
+        std::unique_ptr<uint8_t[]> m_buffer;
+
+        uint8_t* m_cursor;
+
+        uint8_t* m_end;
+    };
+
+    template <class UnderlyingStream = SequentialInputStream>
+    class InlineInputStream final : public SequentialInputStream
+    {
+    public:
+
+        //Lends the bytes of its buffer.
+        static constexpr bool lendsMemory = true;
+
+        InlineInputStream(UnderlyingStream& in, size_t buffer_size = defaultBlockSize) :
+            m_in(in),
+            m_buffer(new uint8_t[buffer_size]),
+            m_capacity(buffer_size),
+            m_cursor(m_buffer.get()),
+            m_end(m_buffer.get())
+        {
+            assert(buffer_size != 0);
+        }
+
+        InlineInputStream(const InlineInputStream&) = delete;
+
+        InlineInputStream& operator = (const InlineInputStream&) = delete;
+
+        bool End() override
+        {
+            return m_cursor == m_end && Fill(1) == 0;
+        }
+
+        size_t Read(uint8_t* buffer, size_t count) override
+        {
+            if (count <= static_cast<size_t>(m_end - m_cursor))
+            {
+                if (count != 0)
+                {
+                    std::memcpy(buffer, m_cursor, count);
+
+                    m_cursor += count;
+                }
+
+                return count;
+            }
+
+            return ReadSlow(buffer, count);
+        }
+
+        const uint8_t* Borrow(size_t count) override
+        {
+            const uint8_t* p = Peek(count);
+
+            if (p != nullptr)
+            {
+                m_cursor += count;
+            }
+
+            return p;
+        }
+
+        //The bytes crossing the end of the buffer are moved to its beginning,
+        //so everything that fits into the buffer can be lent.
+        const uint8_t* Peek(size_t count) override
+        {
+            if (count <= static_cast<size_t>(m_end - m_cursor) || (count <= m_capacity && Fill(count) >= count))
+            {
+                return m_cursor;
+            }
+
+            return nullptr;
+        }
+
+    private:
+
+        size_t ReadSlow(uint8_t* buffer, size_t count)
+        {
+            size_t read_count = static_cast<size_t>(m_end - m_cursor);
+
+            if (read_count != 0)
+            {
+                std::memcpy(buffer, m_cursor, read_count);
+            }
+
+            m_cursor = m_end = m_buffer.get();
+
+            const size_t remaining_count = count - read_count;
+
+            //A large block is read directly into the destination.
+            if (remaining_count >= m_capacity)
+            {
+                while (read_count != count)
+                {
+                    const size_t actually_read = m_in.Read(buffer + read_count, count - read_count);
+
+                    if (actually_read == 0)
+                    {
+                        break;
+                    }
+
+                    read_count += actually_read;
+                }
+
+                return read_count;
+            }
+
+            const size_t available_count = std::min(Fill(remaining_count), remaining_count);
+
+            if (available_count != 0)
+            {
+                std::memcpy(buffer + read_count, m_cursor, available_count);
+
+                m_cursor += available_count;
+            }
+
+            return read_count + available_count;
+        }
+
+        //Moves the remaining bytes to the beginning of the buffer and reads until there are at least
+        //count bytes or the underlying stream ends. Returns the number of available bytes.
+        size_t Fill(size_t count)
+        {
+            assert(count <= m_capacity);
+
+            size_t available_count = static_cast<size_t>(m_end - m_cursor);
+
+            if (m_cursor != m_buffer.get())
+            {
+                std::memmove(m_buffer.get(), m_cursor, available_count);
+
+                m_cursor = m_buffer.get();
+                m_end = m_cursor + available_count;
+            }
+
+            while (available_count < count)
+            {
+                const size_t actually_read = m_in.Read(m_end, m_capacity - available_count);
+
+                if (actually_read == 0)
+                {
+                    break;
+                }
+
+                m_end += actually_read;
+
+                available_count += actually_read;
+            }
+
+            return available_count;
+        }
+
+        UnderlyingStream& m_in;
+
+        std::unique_ptr<uint8_t[]> m_buffer;
+
+        const size_t m_capacity;
+
+        uint8_t* m_cursor;
+
+        uint8_t* m_end;
+    };
+}
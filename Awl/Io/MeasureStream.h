@@ -30,5 +30,29 @@ namespace awl
 
             size_t m_pos = 0;
         };
+
+        //Does not derive from SequentialOutputStream, so the calls to Write are not virtual and they are inlined
+        //into the additions when the stream type is known at compile time.
+        class StaticMeasureStream
+        {
+        public:
+
+            constexpr void Write(const uint8_t * buffer, size_t count)
+            {
+                static_cast<void>(buffer);
+                m_pos += count;
+            }
+
+            constexpr size_t GetLength() const
+            {
+                return m_pos;
+            }
+
+        private:
+
+            size_t m_pos = 0;
+        };
+
+        static_assert(sequential_output_stream<StaticMeasureStream>);
     }
 }
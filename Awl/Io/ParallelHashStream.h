@@ -0,0 +1,270 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Awl/Io/HashStream.h"
+#include "Awl/Io/IoException.h"
+#include "Awl/CppStd/Thread.h"
+
+#include <span>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <exception>
+#include <algorithm>
+#include <cstring>
+#include <cassert>
+
+namespace awl::io
+{
+    //Verifies the hashes of the blocks written by HashOutputStream. Every block carries its own hash,
+    //so the blocks are verified in parallel. Only the last block can be shorter than block_size.
+    template <class Hash>
+    void VerifyHashBlocks(std::span<const uint8_t> data, size_t block_size, const Hash& hash = {}, size_t thread_count = DefaultThreadCount())
+    {
+        assert(block_size > Hash::size());
+
+        const size_t block_count = (data.size() + block_size - 1) / block_size;
+
+        std::atomic<size_t> next_block = 0;
+
+        std::atomic<bool> failed = false;
+
+        std::exception_ptr error;
+
+        std::mutex error_mutex;
+
+        auto verify = [&]()
+        {
+            try
+            {
+                for (size_t i = next_block++; i < block_count && !failed; i = next_block++)
+                {
+                    const uint8_t* begin = data.data() + i * block_size;
+
+                    const size_t size = std::min(block_size, data.size() - i * block_size);
+
+                    if (size < Hash::size())
+                    {
+                        throw CorruptionException();
+                    }
+
+                    const uint8_t* hash_begin = begin + size - Hash::size();
+
+                    typename Hash::value_type read_val;
+
+                    std::memcpy(read_val.data(), hash_begin, read_val.size());
+
+                    if (hash(begin, hash_begin) != read_val)
+                    {
+                        throw CorruptionException();
+                    }
+                }
+            }
+            catch (...)
+            {
+                failed = true;
+
+                std::lock_guard lock(error_mutex);
+
+                if (!error)
+                {
+                    error = std::current_exception();
+                }
+            }
+        };
+
+        {
+            std::vector<std::jthread> threads;
+
+            const size_t extra_count = std::min(thread_count, block_count);
+
+            //The calling thread is one of the workers.
+            for (size_t i = 1; i < extra_count; ++i)
+            {
+                threads.emplace_back(verify);
+            }
+
+            verify();
+        }
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    //Reads the format of HashOutputStream, but verifies the blocks in parallel before they are consumed.
+    //Over a memory region, for example, a mapped file, all the blocks are verified at once and then
+    //read and lent without copying. Over a stream, the blocks are loaded and verified in batches.
+    template <class Hash>
+    class ParallelHashInputStream : public SequentialInputStream
+    {
+    public:
+
+        //Lends the bytes of its current block.
+        static constexpr bool lendsMemory = true;
+
+        ParallelHashInputStream(std::span<const uint8_t> data, size_t block_size = defaultBlockSize, Hash hash = {},
+            size_t thread_count = DefaultThreadCount()) :
+            m_hash(hash),
+            blockSize(block_size),
+            threadCount(thread_count),
+            m_region(data)
+        {
+            VerifyHashBlocks(m_region, blockSize, m_hash, threadCount);
+
+            SetBlock(0);
+        }
+
+        ParallelHashInputStream(SequentialInputStream& in, size_t block_size = defaultBlockSize, Hash hash = {},
+            size_t thread_count = DefaultThreadCount(), size_t batch_block_count = defaultBatchBlockCount) :
+            m_hash(hash),
+            blockSize(block_size),
+            threadCount(thread_count),
+            m_in(&in),
+            batchSize(block_size * batch_block_count)
+        {
+            assert(batch_block_count != 0);
+        }
+
+        bool End() override
+        {
+            return !PeekBuf();
+        }
+
+        size_t Read(uint8_t* buffer, size_t count) override
+        {
+            size_t read_count = 0;
+
+            while (read_count != count && PeekBuf())
+            {
+                const size_t copy_count = std::min(m_payloadEnd - m_pos, count - read_count);
+
+                std::memcpy(buffer + read_count, m_region.data() + m_pos, copy_count);
+
+                m_pos += copy_count;
+                read_count += copy_count;
+            }
+
+            return read_count;
+        }
+
+        const uint8_t* Borrow(size_t count) override
+        {
+            const uint8_t* p = Peek(count);
+
+            if (p != nullptr)
+            {
+                m_pos += count;
+            }
+
+            return p;
+        }
+
+        //Only the bytes of the current block can be lent.
+        const uint8_t* Peek(size_t count) override
+        {
+            if (!PeekBuf() || count > m_payloadEnd - m_pos)
+            {
+                return nullptr;
+            }
+
+            return m_region.data() + m_pos;
+        }
+
+    private:
+
+        static constexpr size_t defaultBatchBlockCount = 64;
+
+        bool PeekBuf()
+        {
+            while (m_pos == m_payloadEnd)
+            {
+                const size_t next_block = m_payloadEnd + Hash::size();
+
+                if (next_block < m_region.size())
+                {
+                    SetBlock(next_block);
+                }
+                else if (!LoadBatch())
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        void SetBlock(size_t begin)
+        {
+            m_pos = begin;
+
+            m_payloadEnd = begin + std::min(blockSize, m_region.size() - begin);
+
+            //An empty region.
+            m_payloadEnd = m_payloadEnd > begin ? m_payloadEnd - Hash::size() : begin;
+        }
+
+        bool LoadBatch()
+        {
+            if (m_in == nullptr)
+            {
+                return false;
+            }
+
+            m_batch.resize(batchSize);
+
+            size_t read_count = 0;
+
+            while (read_count != batchSize)
+            {
+                const size_t actually_read = m_in->Read(m_batch.data() + read_count, batchSize - read_count);
+
+                if (actually_read == 0)
+                {
+                    break;
+                }
+
+                read_count += actually_read;
+            }
+
+            m_batch.resize(read_count);
+
+            if (read_count == 0)
+            {
+                return false;
+            }
+
+            VerifyHashBlocks(std::span<const uint8_t>(m_batch), blockSize, m_hash, threadCount);
+
+            m_region = m_batch;
+
+            SetBlock(0);
+
+            return true;
+        }
+
+        const Hash m_hash;
+
+        const size_t blockSize;
+
+        const size_t threadCount;
+
+        SequentialInputStream* m_in = nullptr;
+
+        const size_t batchSize = 0;
+
+        std::vector<uint8_t> m_batch;
+
+        //Verified blocks.
+        std::span<const uint8_t> m_region;
+
+        size_t m_pos = 0;
+
+        size_t m_payloadEnd = 0;
+    };
+}
@@ -0,0 +1,511 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Awl/Io/HashStream.h"
+#include "Awl/CppStd/Thread.h"
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <exception>
+#include <functional>
+#include <cstring>
+#include <utility>
+#include <cassert>
+
+//The streams below write and read the same format as HashOutputStream and HashInputStream,
+//but the hashing and the underlying I/O are done by a worker thread, so they overlap
+//with filling or consuming the next block.
+
+namespace awl::io
+{
+    constexpr size_t defaultPipelineDepth = 4;
+
+    //The blocks passed between a stream and its worker thread. The buffers are recycled,
+    //and at most depth blocks are queued at a time.
+    class BlockPipe
+    {
+    public:
+
+        struct Block
+        {
+            std::vector<uint8_t> data;
+
+            //The stream is over after this block.
+            bool last = false;
+
+            std::exception_ptr error;
+        };
+
+        explicit BlockPipe(size_t depth) : m_depth(depth)
+        {
+            assert(m_depth != 0);
+        }
+
+        //Waits for a free place in the pipe and returns a recycled buffer.
+        //Returns false if the stop has been requested.
+        bool Reserve(std::vector<uint8_t>& buffer, std::stop_token token = {})
+        {
+            std::unique_lock lock(m_mutex);
+
+            if (!m_cv.wait(lock, token, [this]() { return m_queue.size() + m_busy < m_depth; }))
+            {
+                return false;
+            }
+
+            if (!m_free.empty())
+            {
+                buffer = std::move(m_free.back());
+                m_free.pop_back();
+            }
+
+            return true;
+        }
+
+        void Push(Block block)
+        {
+            {
+                std::lock_guard lock(m_mutex);
+
+                m_queue.push_back(std::move(block));
+            }
+
+            m_cv.notify_all();
+        }
+
+        //Waits for a block and marks it busy until it is released.
+        //Returns false if the stop has been requested.
+        bool Pop(Block& block, std::stop_token token = {})
+        {
+            std::unique_lock lock(m_mutex);
+
+            if (!m_cv.wait(lock, token, [this]() { return !m_queue.empty(); }))
+            {
+                return false;
+            }
+
+            block = std::move(m_queue.front());
+            m_queue.pop_front();
+
+            ++m_busy;
+
+            return true;
+        }
+
+        void Release(std::vector<uint8_t> buffer)
+        {
+            {
+                std::lock_guard lock(m_mutex);
+
+                assert(m_busy != 0);
+
+                --m_busy;
+
+                buffer.clear();
+
+                m_free.push_back(std::move(buffer));
+            }
+
+            m_cv.notify_all();
+        }
+
+        void SetError(std::exception_ptr error)
+        {
+            std::lock_guard lock(m_mutex);
+
+            m_error = std::move(error);
+        }
+
+        std::exception_ptr TakeError()
+        {
+            std::lock_guard lock(m_mutex);
+
+            return std::exchange(m_error, nullptr);
+        }
+
+        //Waits until all the pushed blocks are released.
+        void Drain()
+        {
+            std::unique_lock lock(m_mutex);
+
+            m_cv.wait(lock, [this]() { return m_queue.empty() && m_busy == 0; });
+        }
+
+    private:
+
+        const size_t m_depth;
+
+        std::mutex m_mutex;
+
+        awl::condition_variable_any m_cv;
+
+        std::deque<Block> m_queue;
+
+        std::vector<std::vector<uint8_t>> m_free;
+
+        size_t m_busy = 0;
+
+        std::exception_ptr m_error;
+    };
+
+    template <class Hash, class UnderlyingStream = SequentialOutputStream>
+    class PipelinedHashOutputStream : public SequentialOutputStream
+    {
+    public:
+
+        PipelinedHashOutputStream(UnderlyingStream& out, size_t block_size = defaultBlockSize, Hash hash = {}, size_t depth = defaultPipelineDepth) :
+            m_hash(hash),
+            m_out(out),
+            blockSize(block_size),
+            m_pipe(depth),
+            m_thread(std::bind(&PipelinedHashOutputStream::ThreadProc, this, std::placeholders::_1))
+        {
+            assert(blockSize > Hash::size());
+
+            m_block.reserve(blockSize);
+        }
+
+        PipelinedHashOutputStream(UnderlyingStream& out, Hash hash) : PipelinedHashOutputStream(out, defaultBlockSize, hash)
+        {
+        }
+
+        //The destructor writes the last block, but can't report an error, call Close() to observe it.
+        ~PipelinedHashOutputStream()
+        {
+            if (!m_closed)
+            {
+                m_closed = true;
+
+                try
+                {
+                    if (!m_block.empty())
+                    {
+                        Submit();
+                    }
+                }
+                catch (...)
+                {
+                }
+
+                m_pipe.Drain();
+
+                static_cast<void>(m_pipe.TakeError());
+            }
+        }
+
+        void Write(const uint8_t* buffer, size_t count) override
+        {
+            assert(!m_closed);
+
+            const size_t data_size = blockSize - Hash::size();
+
+            while (count != 0)
+            {
+                const size_t insert_count = std::min(data_size - m_block.size(), count);
+
+                m_block.insert(m_block.end(), buffer, buffer + insert_count);
+
+                if (m_block.size() == data_size)
+                {
+                    Submit();
+                }
+
+                buffer += insert_count;
+                count -= insert_count;
+            }
+        }
+
+        //Writes the last incomplete block and waits until the worker thread writes everything.
+        //Rethrows the exception thrown by the underlying stream, so it should be called to observe the errors
+        //of the blocks written in the background. Only the last block can be incomplete,
+        //so nothing can be written after that.
+        void Close()
+        {
+            m_closed = true;
+
+            if (!m_block.empty())
+            {
+                Submit();
+            }
+
+            m_pipe.Drain();
+
+            CheckError();
+        }
+
+    private:
+
+        void Submit()
+        {
+            std::vector<uint8_t> buffer;
+
+            m_pipe.Reserve(buffer);
+
+            CheckError();
+
+            buffer.reserve(blockSize);
+
+            std::swap(buffer, m_block);
+
+            BlockPipe::Block block;
+
+            block.data = std::move(buffer);
+
+            m_pipe.Push(std::move(block));
+        }
+
+        void CheckError()
+        {
+            if (std::exception_ptr error = m_pipe.TakeError())
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+        void ThreadProc(std::stop_token token)
+        {
+            BlockPipe::Block block;
+
+            while (m_pipe.Pop(block, token))
+            {
+                //Nothing is written after a failure.
+                if (!m_failed)
+                {
+                    try
+                    {
+                        auto val = m_hash(block.data.data(), block.data.data() + block.data.size());
+
+                        block.data.insert(block.data.end(), val.begin(), val.end());
+
+                        m_out.Write(block.data.data(), block.data.size());
+                    }
+                    catch (...)
+                    {
+                        m_failed = true;
+
+                        m_pipe.SetError(std::current_exception());
+                    }
+                }
+
+                m_pipe.Release(std::move(block.data));
+            }
+        }
+
+        const Hash m_hash;
+
+        UnderlyingStream& m_out;
+
+        const size_t blockSize;
+
+        std::vector<uint8_t> m_block;
+
+        bool m_closed = false;
+
+        //Accessed only by the worker thread.
+        bool m_failed = false;
+
+        BlockPipe m_pipe;
+
+        //Started last and stopped first.
+        std::jthread m_thread;
+    };
+
+    template <class Hash, class UnderlyingStream = SequentialInputStream>
+    class PipelinedHashInputStream : public SequentialInputStream
+    {
+    public:
+
+        //Lends the bytes of its current block.
+        static constexpr bool lendsMemory = true;
+
+        PipelinedHashInputStream(UnderlyingStream& in, size_t block_size = defaultBlockSize, Hash hash = {}, size_t depth = defaultPipelineDepth) :
+            m_hash(hash),
+            m_in(in),
+            blockSize(block_size),
+            m_pipe(depth),
+            m_thread(std::bind(&PipelinedHashInputStream::ThreadProc, this, std::placeholders::_1))
+        {
+            assert(blockSize > Hash::size());
+        }
+
+        PipelinedHashInputStream(UnderlyingStream& in, Hash hash) : PipelinedHashInputStream(in, defaultBlockSize, hash)
+        {
+        }
+
+        bool End() override
+        {
+            return !PeekBuf();
+        }
+
+        size_t Read(uint8_t* buffer, size_t count) override
+        {
+            size_t read_count = 0;
+
+            while (read_count != count && PeekBuf())
+            {
+                const size_t copy_count = std::min(m_block.size() - m_pos, count - read_count);
+
+                std::memcpy(buffer + read_count, m_block.data() + m_pos, copy_count);
+
+                m_pos += copy_count;
+                read_count += copy_count;
+            }
+
+            return read_count;
+        }
+
+        const uint8_t* Borrow(size_t count) override
+        {
+            const uint8_t* p = Peek(count);
+
+            if (p != nullptr)
+            {
+                m_pos += count;
+            }
+
+            return p;
+        }
+
+        //Only the bytes of the current block can be lent.
+        const uint8_t* Peek(size_t count) override
+        {
+            if (!PeekBuf() || count > m_block.size() - m_pos)
+            {
+                return nullptr;
+            }
+
+            return m_block.data() + m_pos;
+        }
+
+    private:
+
+        //Takes the next verified block if the current one is over.
+        //Returns false at the end of the stream.
+        bool PeekBuf()
+        {
+            while (m_pos == m_block.size())
+            {
+                if (m_last)
+                {
+                    return false;
+                }
+
+                if (m_popped)
+                {
+                    m_pipe.Release(std::move(m_block));
+                }
+
+                BlockPipe::Block block;
+
+                m_pipe.Pop(block);
+
+                m_popped = true;
+
+                m_block = std::move(block.data);
+                m_pos = 0;
+                m_last = block.last;
+
+                if (block.error)
+                {
+                    std::rethrow_exception(block.error);
+                }
+            }
+
+            return true;
+        }
+
+        void ThreadProc(std::stop_token token)
+        {
+            bool last = false;
+
+            while (!last)
+            {
+                BlockPipe::Block block;
+
+                if (!m_pipe.Reserve(block.data, token))
+                {
+                    break;
+                }
+
+                try
+                {
+                    ReadBlock(block.data);
+
+                    last = block.data.empty();
+                }
+                catch (...)
+                {
+                    block.data.clear();
+
+                    block.error = std::current_exception();
+
+                    last = true;
+                }
+
+                block.last = last;
+
+                m_pipe.Push(std::move(block));
+            }
+        }
+
+        void ReadBlock(std::vector<uint8_t>& v)
+        {
+            v.resize(blockSize);
+
+            const size_t actually_read = m_in.Read(v.data(), blockSize);
+
+            assert(actually_read <= blockSize);
+
+            if (actually_read == 0)
+            {
+                //Nothing to read, we are at the end of the file.
+                v.clear();
+
+                return;
+            }
+
+            if (actually_read < Hash::size())
+            {
+                throw CorruptionException();
+            }
+
+            const uint8_t* data = v.data();
+
+            const uint8_t* hash_begin = data + actually_read - Hash::size();
+
+            typename Hash::value_type read_val;
+
+            std::memcpy(read_val.data(), hash_begin, read_val.size());
+
+            if (m_hash(data, hash_begin) != read_val)
+            {
+                throw CorruptionException();
+            }
+
+            v.resize(actually_read - Hash::size());
+        }
+
+        const Hash m_hash;
+
+        UnderlyingStream& m_in;
+
+        const size_t blockSize;
+
+        std::vector<uint8_t> m_block;
+
+        size_t m_pos = 0;
+
+        bool m_popped = false;
+
+        bool m_last = false;
+
+        BlockPipe m_pipe;
+
+        //Started last and stopped first.
+        std::jthread m_thread;
+    };
+}
@@ -15,6 +15,7 @@
 #include "Awl/Io/Rw/TuplizableReadWrite.h"
 #include "Awl/Io/Rw/VariantReadWrite.h"
 #include "Awl/Io/Rw/VectorReadWrite.h"
+#include "Awl/Io/Rw/ViewReadWrite.h"
 #include "Awl/Io/Rw/DecimalReadWrite.h"
 #include "Awl/Io/Rw/PointerReadWrite.h"
 #include "Awl/Io/Rw/EnumReadWrite.h"
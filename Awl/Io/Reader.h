@@ -16,6 +16,9 @@
 #include <cassert>
 #include <optional>
 #include <vector>
+#include <algorithm>
+#include <cstring>
+#include <memory_resource>
 
 namespace awl::io
 {
@@ -30,105 +33,39 @@ namespace awl::io
 
         using Base = BasicReader<V, IStream>;
 
-        template <class Struct>
-        struct FieldReader
-        {
-            virtual void ReadField(const Reader & context, InputStream & in, Struct & val) const = 0;
-        };
-
-        template <class Struct, size_t index>
-        class FieldReaderImpl : public FieldReader<Struct>
+        //The plan of reading an old structure into a new one, it is built once per old prototype.
+        struct ReadOp
         {
-        public:
-
-            void ReadField(const Reader & context, InputStream & in, Struct & val) const override
+            enum class Kind : uint8_t
             {
-                auto & field_val = std::get<index>(val.as_tuple());
+                ReadField,
+                SkipBytes,
+                SkipByType,
+                SkipStruct
+            };
 
-                if constexpr (is_reflectable_v<std::remove_reference_t<decltype(field_val)>>)
-                {
-                    context.ReadV(in, field_val);
-                }
-                else
-                {
-                    Read(in, field_val, context);
-                }
-            }
-        };
+            Kind kind;
 
-        struct FieldSkipper
-        {
-            virtual void SkipField(const Reader & context, InputStream & in) const = 0;
-        };
-
-        template <class Field>
-        class FieldSkipperImpl : public FieldSkipper
-        {
-        public:
+            //The index of the new field, the byte count or the old type.
+            size_t value;
 
-            void SkipField(const Reader & context, InputStream & in) const override
-            {
-                // It is the only place where Field type is required to be default constructable.
-                Field val;
-                context.ReadV(in, val);
-            }
+            //The first old field the operation reads or skips.
+            size_t oldIndex;
         };
 
-        template <class Struct>
-        struct FieldReaderTupleCreator
+        struct ReadPlan
         {
-            static constexpr size_t fieldCount = std::tuple_size_v<typename tuplizable_traits<Struct>::Tie>;
-
-            template <std::size_t... index>
-            static auto MakeTuple(std::index_sequence<index...>)
-            {
-                return std::make_tuple(FieldReaderImpl<Struct, index>()...);
-            }
-
-            static auto MakeTuple()
-            {
-                return MakeTuple(std::make_index_sequence<fieldCount>());
-            }
-        };
-
-        template <class Struct>
-        using FieldReaderTuple = decltype(FieldReaderTupleCreator<Struct>::MakeTuple());
-
-        template <class Struct>
-        using FieldReaderArray = std::array<const FieldReader<Struct> *, FieldReaderTupleCreator<Struct>::fieldCount>;
-
-        template <size_t index>
-        struct FieldReaderArrayHolder
-        {
-            using Struct = std::variant_alternative_t<index, typename Base::StructV>;
-
-            FieldReaderArrayHolder(const FieldReaderTuple<Struct> & t) :
-                a(tuple_cast<const FieldReader<Struct>>(t))
-            {
-            }
-
-            FieldReaderArray<Struct> a;
-        };
-
-        using TupleOfFieldReaderTuple = decltype(transform_v2t<typename Base::StructV, FieldReaderTuple>());
-        using TupleOfFieldReaderArray = decltype(transform_t2ti<FieldReaderArrayHolder>(TupleOfFieldReaderTuple{}));
+            size_t newStructIndex;
 
-        using SkipperTuple = decltype(transform_v2t<typename Base::FieldV, FieldSkipperImpl>());
-        using SkipperArray = std::array<FieldSkipper *, std::variant_size_v<typename Base::FieldV>>;
+            //The prototypes are equal, so the structure is read as a tuple.
+            bool sequential;
 
-        struct ProtoMap
-        {
-            size_t newStructIndex;
-            std::vector<size_t> fieldMap;
+            std::vector<ReadOp> ops;
         };
         
     public:
 
         Reader() :
-            readerTuples(transform_v2t<typename Base::StructV, FieldReaderTuple>()),
-            readerArrays(transform_t2ti<FieldReaderArrayHolder>(readerTuples)),
-            skipperTuple(transform_v2t<typename Base::FieldV, FieldSkipperImpl>()),
-            skipperArray(tuple_cast<FieldSkipper>(skipperTuple)),
             typeMap(Base::TypeMapBuilder::BuildI2nMap())
         {
         }
@@ -144,6 +81,8 @@ namespace awl::io
             {
                 oldPrototypes.push_back(DetachedPrototype(*p));
             }
+
+            readPlans.resize(oldPrototypes.size());
         }
 
         //We can't handle the situation when type representation changes,
@@ -216,12 +155,16 @@ namespace awl::io
             }
 
             oldPrototypes = protos;
+
+            //The plans are built on the first read, because an old prototype is bound to a new structure by its reader.
+            readPlans.clear();
+            readPlans.resize(oldPrototypes.size());
         }
 
         void ClearPrototypes()
         {
             oldPrototypes.clear();
-            protoMaps.clear();
+            readPlans.clear();
         }
 
         template<class Struct>
@@ -229,63 +172,87 @@ namespace awl::io
         {
             if constexpr (is_reflectable_v<Struct>)
             {
-                typename Base::StructIndexType old_struct_index = ReadStructIndex(s);
+                ReadStruct(s, val, ReadStructIndex(s));
+            }
+            else if constexpr (is_tuplizable_v<Struct>)
+            {
+                ReadTuplizable(s, val);
+            }
+            else
+            {
+                Read(s, val, *this);
+            }
+        }
 
-                const std::vector<size_t> name_map = this->template FindProtoMap<Struct>(old_struct_index);
+        //Reads an array of the structures written by Writer::WriteArrayV or by WriteV.
+        //If the prototypes are equal, the elements are copied from a single block of memory.
+        template<class Struct>
+            requires (packed_tuplizable<Struct> && is_reflectable_v<Struct>)
+        void ReadArrayV(InputStream & s, Struct * data, size_t count) const
+        {
+            using StructIndexType = typename Base::StructIndexType;
 
-                //An empty map means either an empty structure or equal prototypes
-                //(the prototypes of empty structures are equal).
-                if (name_map.empty())
-                {
-                    //Read in the same way we write it.
-                    ReadTuplizable(s, val);
-                }
-                else
-                {
-                    auto & new_proto = this->template FindNewPrototype<Struct>();
-                    const DetachedPrototype & old_proto = oldPrototypes[old_struct_index];
+            if (count == 0)
+            {
+                return;
+            }
 
-                    assert(name_map.size() == old_proto.GetCount());
+            const StructIndexType old_struct_index = ReadStructIndex(s);
 
-                    for (size_t old_index = 0; old_index < name_map.size(); ++old_index)
-                    {
-                        const Field old_field = old_proto.GetField(old_index);
+            ReadStruct(s, data[0], old_struct_index);
+
+            if (!FindReadPlan<Struct>(old_struct_index).sequential || !CanCopyRaw<Struct>())
+            {
+                for (size_t i = 1; i < count; ++i)
+                {
+                    ReadV(s, data[i]);
+                }
 
-                        const size_t new_index = name_map[old_index];
+                return;
+            }
 
-                        if (new_index == Prototype::NoIndex)
-                        {
-                            if (!this->allowDelete)
-                            {
-                                throw FieldNotFoundException(std::string(old_field.name));
-                            }
+            //The rest of the elements are preceded by the same index.
+            constexpr size_t elementSize = sizeof(StructIndexType) + sizeof(Struct);
 
-                            SkipField(s, old_field);
-                        }
-                        else
-                        {
-                            const auto new_field = new_proto.GetField(new_index);
+            auto copy_elements = [old_struct_index](const uint8_t* p, Struct * begin, Struct * end)
+            {
+                for (Struct * dst = begin; dst != end; ++dst, p += elementSize)
+                {
+                    StructIndexType index;
 
-                            //The names are equal if a structure contains vector<A> and set<A>, for example.
-                            if (!AreTypesEqual(old_field.type, new_field.type))
-                            {
-                                throw TypeMismatchException(std::string(new_field.name), new_field.type, old_field.type);
-                            }
+                    std::memcpy(&index, p, sizeof(index));
 
-                            //We read by index, not by type, so we call ReadField for both structures and fields.
-                            auto & readers = this->template FindFieldReaders<Struct>();
-                            readers[new_index]->ReadField(*this, s, val);
-                        }
+                    if (index != old_struct_index)
+                    {
+                        throw CorruptionException();
                     }
+
+                    std::memcpy(dst, p + sizeof(index), sizeof(Struct));
                 }
-            }
-            else if constexpr (is_tuplizable_v<Struct>)
+            };
+
+            const size_t rest_count = count - 1;
+
+            if (const uint8_t* p = TryBorrow(s, rest_count * elementSize))
             {
-                ReadTuplizable(s, val);
+                copy_elements(p, data + 1, data + count);
+
+                return;
             }
-            else
+
+            constexpr size_t chunkCount = std::max<size_t>(1, 4096 / elementSize);
+
+            std::vector<uint8_t> buffer(std::min(rest_count, chunkCount) * elementSize);
+
+            for (size_t i = 1; i < count;)
             {
-                Read(s, val, *this);
+                const size_t chunk_count = std::min(count - i, chunkCount);
+
+                ReadRaw(s, buffer.data(), chunk_count * elementSize);
+
+                copy_elements(buffer.data(), data + i, data + i + chunk_count);
+
+                i += chunk_count;
             }
         }
 
@@ -294,8 +261,7 @@ namespace awl::io
             if (old_field.type != Field::NoType)
             {
                 //Skip by type.
-                auto & skippers = this->GetFieldSkippers();
-                skippers[old_field.type]->SkipField(*this, s);
+                SkipFieldOfType(s, old_field.type);
             }
             else
             {
@@ -317,22 +283,88 @@ namespace awl::io
             }
         }
 
+        //The pmr containers of the structures are read with this memory resource if it is not null.
+        std::pmr::memory_resource* memory_resource() const
+        {
+            return memoryResource;
+        }
+
         bool allowTypeMismatch = false;
         bool allowDelete = true;
 
+        std::pmr::memory_resource* memoryResource = nullptr;
+
     private:
 
-        template <class S>
-        auto & FindFieldReaders() const
+        //The fields are read and skipped by the indices known at runtime, but the calls are dispatched
+        //with jump tables generated at compile time, so they can be inlined.
+
+        template <class Struct>
+        void ReadField(InputStream & in, Struct & val, size_t field_index) const
         {
-            constexpr size_t index = Base::template StructIndex<S>;
-            auto & holder = std::get<index>(readerArrays);
-            return holder.a;
+            constexpr size_t fieldCount = std::tuple_size_v<typename tuplizable_traits<Struct>::Tie>;
+
+            [[maybe_unused]] const bool found = visit_index<fieldCount>(field_index, [this, &in, &val](auto index)
+            {
+                auto & field_val = std::get<index>(val.as_tuple());
+
+                if constexpr (is_reflectable_v<std::remove_reference_t<decltype(field_val)>>)
+                {
+                    this->ReadV(in, field_val);
+                }
+                else
+                {
+                    Read(in, field_val, *this);
+                }
+            });
+
+            assert(found);
         }
 
-        const SkipperArray & GetFieldSkippers() const
+        void SkipFieldOfType(InputStream & in, size_t type) const
         {
-            return skipperArray;
+            constexpr size_t typeCount = std::variant_size_v<typename Base::FieldV>;
+
+            [[maybe_unused]] const bool found = visit_index<typeCount>(type, [this, &in](auto index)
+            {
+                //It is the only place where Field type is required to be default constructable.
+                std::variant_alternative_t<index, typename Base::FieldV> val;
+                this->ReadV(in, val);
+            });
+
+            assert(found);
+        }
+
+        //Returns the size of the field if it does not depend on the value, otherwise zero.
+        size_t GetFixedSize(size_t type) const
+        {
+            constexpr size_t typeCount = std::variant_size_v<typename Base::FieldV>;
+
+            size_t size = 0;
+
+            visit_index<typeCount>(type, [this, &size](auto index)
+            {
+                using FieldType = std::variant_alternative_t<index, typename Base::FieldV>;
+
+                if constexpr (std::is_same_v<FieldType, bool>)
+                {
+                    size = 1;
+                }
+                else if constexpr (std::is_arithmetic_v<FieldType>)
+                {
+                    if constexpr (varint_integral<FieldType>)
+                    {
+                        if (IsCompact(*this))
+                        {
+                            return;
+                        }
+                    }
+
+                    size = sizeof(FieldType);
+                }
+            });
+
+            return size;
         }
 
         typename Base::StructIndexType ReadStructIndex(InputStream & s) const
@@ -353,46 +385,162 @@ namespace awl::io
         }
 
         template<class Struct>
-        std::vector<size_t> FindProtoMap(typename Base::StructIndexType old_struct_index) const
+            requires packed_tuplizable<Struct>
+        bool CanCopyRaw() const
         {
-            assert(old_struct_index < oldPrototypes.size());
+            return !IsCompact(*this) && HasPackedLayout<Struct>();
+        }
 
-            constexpr size_t new_index = Base::template StructIndex<Struct>;
+        template<class Struct>
+        void ReadStruct(InputStream & s, Struct & val, typename Base::StructIndexType old_struct_index) const
+        {
+            const ReadPlan & plan = FindReadPlan<Struct>(old_struct_index);
 
-            if (old_struct_index < protoMaps.size())
+            if (plan.sequential)
             {
-                std::optional<ProtoMap> & pm = protoMaps[old_struct_index];
-                
-                if (pm.has_value())
+                if constexpr (packed_tuplizable<Struct>)
                 {
-                    if (new_index != pm->newStructIndex)
+                    if (CanCopyRaw<Struct>())
                     {
-                        throw IoError(format() << _T("Inconsisten structure indices: new index 1: ") << pm->newStructIndex << 
-                            _T(" new index 2: ") << new_index << _T(" old index: ") << old_struct_index << _T("."));
-                    }
+                        //The structure is read as a single block.
+                        if (const uint8_t* p = TryBorrow(s, sizeof(Struct)))
+                        {
+                            std::memcpy(&val, p, sizeof(Struct));
+                        }
+                        else
+                        {
+                            ReadRaw(s, reinterpret_cast<uint8_t*>(&val), sizeof(Struct));
+                        }
 
-                    return pm->fieldMap;
+                        return;
+                    }
                 }
+
+                //Read in the same way we write it.
+                ReadTuplizable(s, val);
             }
             else
             {
-                protoMaps.resize(old_struct_index + 1);
+                ExecuteReadPlan(s, val, plan, oldPrototypes[old_struct_index]);
             }
-            
-            std::optional<ProtoMap> & pm = protoMaps[old_struct_index];
+        }
+
+        template<class Struct>
+        void ExecuteReadPlan(InputStream & s, Struct & val, const ReadPlan & plan, const DetachedPrototype & old_proto) const
+        {
+            for (const ReadOp & op : plan.ops)
+            {
+                if (op.kind == ReadOp::Kind::ReadField)
+                {
+                    //We read by index, not by type, so we call ReadField for both structures and fields.
+                    ReadField(s, val, op.value);
+
+                    continue;
+                }
+
+                if (!this->allowDelete)
+                {
+                    throw FieldNotFoundException(std::string(old_proto.GetField(op.oldIndex).name));
+                }
 
-            pm = ProtoMap{};
-            assert(pm.has_value());
-            pm->newStructIndex = new_index;
-            pm->fieldMap = MakeProtoMap<Struct>(old_struct_index, new_index);
+                switch (op.kind)
+                {
+                    case ReadOp::Kind::SkipBytes:
+                        SkipRaw(s, op.value);
+                        break;
+                    case ReadOp::Kind::SkipByType:
+                        SkipFieldOfType(s, op.value);
+                        break;
+                    default:
+                        SkipStruct(s);
+                        break;
+                }
+            }
+        }
+
+        template<class Struct>
+        const ReadPlan & FindReadPlan(typename Base::StructIndexType old_struct_index) const
+        {
+            assert(old_struct_index < readPlans.size());
+
+            constexpr size_t new_index = Base::template StructIndex<Struct>;
+
+            std::optional<ReadPlan> & plan = readPlans[old_struct_index];
 
-            return pm->fieldMap;
+            if (plan.has_value())
+            {
+                if (new_index != plan->newStructIndex)
+                {
+                    throw IoError(format() << _T("Inconsisten structure indices: new index 1: ") << plan->newStructIndex << 
+                        _T(" new index 2: ") << new_index << _T(" old index: ") << old_struct_index << _T("."));
+                }
+            }
+            else
+            {
+                //The vector is not resized here, so the references to the other plans remain valid.
+                plan = MakeReadPlan<Struct>(old_struct_index, new_index);
+            }
+
+            return *plan;
         }
 
         template<class Struct>
-        std::vector<size_t> MakeProtoMap(typename Base::StructIndexType old_struct_index, typename Base::StructIndexType new_struct_index) const
+        ReadPlan MakeReadPlan(typename Base::StructIndexType old_struct_index, size_t new_struct_index) const
         {
-            return MapPrototypes<Struct>(oldPrototypes[old_struct_index], *(this->newPrototypes[new_struct_index]));
+            const DetachedPrototype & old_proto = oldPrototypes[old_struct_index];
+            const Prototype & new_proto = *(this->newPrototypes[new_struct_index]);
+
+            const std::vector<size_t> name_map = MapPrototypes<Struct>(old_proto, new_proto);
+
+            //An empty map with different field counts means the old structure has no fields.
+            ReadPlan plan{ new_struct_index, name_map.empty() && old_proto.GetCount() == new_proto.GetCount(), {} };
+
+            if (plan.sequential)
+            {
+                return plan;
+            }
+
+            for (size_t old_index = 0; old_index < name_map.size(); ++old_index)
+            {
+                const Field old_field = old_proto.GetField(old_index);
+
+                const size_t new_index = name_map[old_index];
+
+                if (new_index != Prototype::NoIndex)
+                {
+                    const auto new_field = new_proto.GetField(new_index);
+
+                    //The names are equal if a structure contains vector<A> and set<A>, for example.
+                    if (!AreTypesEqual(old_field.type, new_field.type))
+                    {
+                        throw TypeMismatchException(std::string(new_field.name), new_field.type, old_field.type);
+                    }
+
+                    plan.ops.push_back(ReadOp{ ReadOp::Kind::ReadField, new_index, old_index });
+                }
+                else if (old_field.type == Field::NoType)
+                {
+                    plan.ops.push_back(ReadOp{ ReadOp::Kind::SkipStruct, 0, old_index });
+                }
+                else if (const size_t size = GetFixedSize(old_field.type); size != 0)
+                {
+                    //Adjacent deleted fields of fixed size are skipped at once.
+                    if (!plan.ops.empty() && plan.ops.back().kind == ReadOp::Kind::SkipBytes)
+                    {
+                        plan.ops.back().value += size;
+                    }
+                    else
+                    {
+                        plan.ops.push_back(ReadOp{ ReadOp::Kind::SkipBytes, size, old_index });
+                    }
+                }
+                else
+                {
+                    plan.ops.push_back(ReadOp{ ReadOp::Kind::SkipByType, old_field.type, old_index });
+                }
+            }
+
+            return plan;
         }
 
         template<class Struct>
@@ -477,14 +625,8 @@ namespace awl::io
             return old_name == new_name;
         }
 
-        TupleOfFieldReaderTuple readerTuples;
-        TupleOfFieldReaderArray readerArrays;
-
-        SkipperTuple skipperTuple;
-        SkipperArray skipperArray;
-
         PrototypeVector oldPrototypes;
-        mutable std::vector<std::optional<ProtoMap>> protoMaps;
+        mutable std::vector<std::optional<ReadPlan>> readPlans;
 
         typename Base::I2nMap typeMap;
     };
@@ -0,0 +1,357 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Awl/Io/Stream.h"
+#include "Awl/Io/Reader.h"
+#include "Awl/Io/Writer.h"
+#include "Awl/Io/VectorStream.h"
+#include "Awl/Io/IoException.h"
+#include "Awl/Io/Rw/VarInt.h"
+#include "Awl/Mp/Mp.h"
+#include "Awl/StringFormat.h"
+
+#include <vector>
+#include <iterator>
+#include <cstdint>
+#include <cstddef>
+
+//A file of the records that can be read in an arbitrary order:
+//
+//    the magic number;
+//    the prototypes written by Writer::WriteNewPrototypes;
+//    the records, each record is WriteV of an object preceded by its size in the varint encoding,
+//    so the records can also be read sequentially without the index;
+//    the index, that is the array of 64-bit record offsets;
+//    the footer.
+//
+//The footer is at the end of the file, so any record is found with two seeks.
+
+namespace awl::io
+{
+    inline constexpr uint64_t recordFileMagic = 0x3153445243524C41; //"ALRCRDS1"
+
+    struct RecordFileFooter
+    {
+        uint64_t indexOffset;
+
+        uint64_t recordCount;
+
+        uint64_t magic;
+    };
+
+    template <class Record, class OStream = SequentialOutputStream, class V = mp::variant_from_struct<Record>>
+        requires sequential_output_stream<OStream>
+    class RecordFileWriter
+    {
+    public:
+
+        RecordFileWriter(OStream & out) : m_out(out)
+        {
+            Put(reinterpret_cast<const uint8_t*>(&recordFileMagic), sizeof(recordFileMagic));
+
+            {
+                VectorOutputStream buffer_out(m_buffer);
+
+                m_ctx.WriteNewPrototypes(buffer_out);
+            }
+
+            Put(m_buffer.data(), m_buffer.size());
+        }
+
+        RecordFileWriter(const RecordFileWriter&) = delete;
+        RecordFileWriter& operator = (const RecordFileWriter&) = delete;
+
+        ~RecordFileWriter()
+        {
+            Finish();
+        }
+
+        void Write(const Record & val)
+        {
+            assert(!m_finished);
+
+            m_buffer.clear();
+
+            {
+                VectorOutputStream buffer_out(m_buffer);
+
+                m_ctx.WriteV(buffer_out, val);
+            }
+
+            m_offsets.push_back(m_pos);
+
+            uint8_t size_buffer[maxVarIntSize<size_t>];
+
+            const uint8_t* size_end = EncodeVarInt(m_buffer.size(), size_buffer);
+
+            Put(size_buffer, static_cast<size_t>(size_end - size_buffer));
+
+            Put(m_buffer.data(), m_buffer.size());
+        }
+
+        size_t GetCount() const
+        {
+            return m_offsets.size();
+        }
+
+        //Writes the index and the footer, no records can be written after that.
+        void Finish()
+        {
+            if (m_finished)
+            {
+                return;
+            }
+
+            const RecordFileFooter footer = { m_pos, m_offsets.size(), recordFileMagic };
+
+            Put(reinterpret_cast<const uint8_t*>(m_offsets.data()), m_offsets.size() * sizeof(uint64_t));
+
+            Put(reinterpret_cast<const uint8_t*>(&footer), sizeof(footer));
+
+            m_finished = true;
+        }
+
+    private:
+
+        void Put(const uint8_t* buffer, size_t count)
+        {
+            m_out.Write(buffer, count);
+
+            m_pos += count;
+        }
+
+        OStream & m_out;
+
+        Writer<V, VectorOutputStream> m_ctx;
+
+        std::vector<uint8_t> m_buffer;
+
+        std::vector<uint64_t> m_offsets;
+
+        uint64_t m_pos = 0;
+
+        bool m_finished = false;
+    };
+
+    //The file should occupy the whole stream. A record is read through the Reader context,
+    //so a file written with an older version of Record can be read.
+    template <class Record, class IStream = InputStream, class V = mp::variant_from_struct<Record>>
+        requires seekable_input_stream<IStream>
+    class RecordFileReader
+    {
+    public:
+
+        class Iterator
+        {
+        public:
+
+            using iterator_category = std::input_iterator_tag;
+            using value_type = Record;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = Record;
+
+            Iterator() = default;
+
+            Iterator(RecordFileReader & reader, size_t index) : m_reader(&reader), m_index(index)
+            {
+            }
+
+            //The record is read when the iterator is dereferenced.
+            Record operator*() const
+            {
+                return m_reader->ReadRecord(m_index);
+            }
+
+            Iterator & operator++()
+            {
+                ++m_index;
+
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator prev = *this;
+
+                ++m_index;
+
+                return prev;
+            }
+
+            bool operator == (const Iterator & other) const
+            {
+                return m_index == other.m_index;
+            }
+
+        private:
+
+            RecordFileReader * m_reader = nullptr;
+
+            size_t m_index = 0;
+        };
+
+        RecordFileReader(IStream & in) : m_in(in)
+        {
+            const size_t length = m_in.GetLength();
+
+            if (length < sizeof(recordFileMagic) + sizeof(RecordFileFooter))
+            {
+                throw CorruptionException();
+            }
+
+            m_in.Seek(length - sizeof(RecordFileFooter));
+
+            RecordFileFooter footer;
+
+            ReadRaw(m_in, reinterpret_cast<uint8_t*>(&footer), sizeof(footer));
+
+            const size_t index_end = length - sizeof(RecordFileFooter);
+
+            if (footer.magic != recordFileMagic || footer.indexOffset > index_end ||
+                footer.recordCount != (index_end - footer.indexOffset) / sizeof(uint64_t) ||
+                (index_end - footer.indexOffset) % sizeof(uint64_t) != 0)
+            {
+                throw CorruptionException();
+            }
+
+            m_indexOffset = static_cast<size_t>(footer.indexOffset);
+
+            m_count = static_cast<size_t>(footer.recordCount);
+
+            m_in.Seek(0);
+
+            uint64_t magic;
+
+            ReadRaw(m_in, reinterpret_cast<uint8_t*>(&magic), sizeof(magic));
+
+            if (magic != recordFileMagic)
+            {
+                throw CorruptionException();
+            }
+
+            m_ctx.ReadOldPrototypes(m_in);
+
+            m_dataOffset = m_in.GetPosition();
+
+            if (m_dataOffset > m_indexOffset)
+            {
+                throw CorruptionException();
+            }
+        }
+
+        size_t GetCount() const
+        {
+            return m_count;
+        }
+
+        void ReadRecord(size_t index, Record & val)
+        {
+            SeekRecord(index);
+
+            ReadNext(val);
+        }
+
+        Record ReadRecord(size_t index)
+        {
+            Record val;
+
+            ReadRecord(index, val);
+
+            return val;
+        }
+
+        //The records of the range are stored contiguously, so there is a single seek.
+        std::vector<Record> ReadRange(size_t first, size_t count)
+        {
+            if (first > m_count || count > m_count - first)
+            {
+                throw IoError(format() << _T("The range [") << first << _T(", ") << first + count <<
+                    _T(") is out of the record file of ") << m_count << _T(" records."));
+            }
+
+            std::vector<Record> v(count);
+
+            if (count != 0)
+            {
+                SeekRecord(first);
+
+                for (Record & val : v)
+                {
+                    ReadNext(val);
+                }
+            }
+
+            return v;
+        }
+
+        Iterator begin()
+        {
+            return Iterator(*this, 0);
+        }
+
+        Iterator end()
+        {
+            return Iterator(*this, m_count);
+        }
+
+    private:
+
+        void SeekRecord(size_t index)
+        {
+            if (index >= m_count)
+            {
+                throw IoError(format() << _T("Record ") << index << _T(" is out of the record file of ") << m_count << _T(" records."));
+            }
+
+            m_in.Seek(m_indexOffset + index * sizeof(uint64_t));
+
+            uint64_t offset;
+
+            ReadRaw(m_in, reinterpret_cast<uint8_t*>(&offset), sizeof(offset));
+
+            if (offset < m_dataOffset || offset >= m_indexOffset)
+            {
+                throw CorruptionException();
+            }
+
+            m_in.Seek(static_cast<size_t>(offset));
+        }
+
+        //Reads the record at the current position.
+        void ReadNext(Record & val)
+        {
+            size_t size;
+
+            ReadVarInt(m_in, size);
+
+            const size_t begin = m_in.GetPosition();
+
+            if (size > m_indexOffset - begin)
+            {
+                throw CorruptionException();
+            }
+
+            m_ctx.ReadV(m_in, val);
+
+            if (m_in.GetPosition() - begin != size)
+            {
+                throw CorruptionException();
+            }
+        }
+
+        IStream & m_in;
+
+        Reader<V, IStream> m_ctx;
+
+        size_t m_indexOffset;
+
+        size_t m_count;
+
+        size_t m_dataOffset;
+    };
+}
@@ -6,9 +6,11 @@
 #pragma once
 
 #include "Awl/Io/Rw/ReadRaw.h"
+#include "Awl/Io/Rw/VarInt.h"
 #include "Awl/Int2Array.h"
 
 #include <type_traits>
+#include <cstring>
 
 namespace awl::io
 {
@@ -30,7 +32,23 @@ namespace awl::io
         requires (sequential_input_stream<Stream> && std::is_arithmetic_v<T> && !std::is_same<T, bool>::value)
     void Read(Stream & s, T & val, const Context & ctx = {})
     {
-        static_cast<void>(ctx);
+        if constexpr (varint_integral<T>)
+        {
+            if (IsCompact(ctx))
+            {
+                ReadVarInt(s, val);
+
+                return;
+            }
+        }
+
+        //Reading directly from the stream's buffer avoids the chunked copy loop for small values.
+        if (const uint8_t* p = TryBorrow(s, sizeof(T)))
+        {
+            std::memcpy(&val, p, sizeof(T));
+
+            return;
+        }
 
         std::array<std::uint8_t, sizeof(T)> a;
 
@@ -44,8 +62,16 @@ namespace awl::io
         requires (sequential_output_stream<Stream> && std::is_arithmetic_v<T> && !std::is_same<T, bool>::value)
     void Write(Stream & s, T val, const Context & ctx = {})
     {
-        static_cast<void>(ctx);
-        
+        if constexpr (varint_integral<T>)
+        {
+            if (IsCompact(ctx))
+            {
+                WriteVarInt(s, val);
+
+                return;
+            }
+        }
+
         WriteBuffer(s, to_buffer(val));
     }
 
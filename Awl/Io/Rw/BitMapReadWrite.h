@@ -10,8 +10,12 @@
 #include "Awl/Io/Rw/RwAdapters.h"
 #include "Awl/Io/SequentialStream.h"
 #include "Awl/BitMap.h"
+#include "Awl/DynamicBitMap.h"
 
 #include <bitset>
+#include <span>
+#include <vector>
+#include <algorithm>
 #include <type_traits>
 
 namespace awl::io
@@ -52,4 +56,48 @@ namespace awl::io
 
         WriteVector(s, a, ctx);
     }
+
+    //The size in bits followed by the words.
+    template <class Stream, class Allocator, class Context = FakeContext>
+        requires sequential_input_stream<Stream>
+    void Read(Stream & s, basic_dynamic_bitmap<Allocator> & v, const Context & ctx = {})
+    {
+        using Bitmap = basic_dynamic_bitmap<Allocator>;
+
+        typename Bitmap::size_type size;
+
+        Read(s, size, ctx);
+
+        const size_t word_count = size / Bitmap::word_bits + (size % Bitmap::word_bits != 0 ? 1 : 0);
+
+        //The size is not trusted, so the words are allocated while they are read
+        //and a corrupted size ends with EndOfFileException instead of a huge allocation.
+        constexpr size_t maxStepWordCount = 64 * 1024;
+
+        std::vector<typename Bitmap::word_type, Allocator> words;
+
+        while (words.size() < word_count)
+        {
+            const size_t offset = words.size();
+
+            words.resize(offset + std::min(word_count - offset, maxStepWordCount));
+
+            std::span<typename Bitmap::word_type> step(words.data() + offset, words.size() - offset);
+
+            ReadVector(s, step, ctx);
+        }
+
+        v = Bitmap(size, std::move(words));
+    }
+
+    template <class Stream, class Allocator, class Context = FakeContext>
+        requires sequential_output_stream<Stream>
+    void Write(Stream & s, const basic_dynamic_bitmap<Allocator> & v, const Context & ctx = {})
+    {
+        typename basic_dynamic_bitmap<Allocator>::size_type size = v.size();
+
+        Write(s, size, ctx);
+
+        WriteVector(s, v.words(), ctx);
+    }
 }
@@ -0,0 +1,217 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Awl/Io/ReadWrite.h"
+#include "Awl/Io/VectorStream.h"
+#include "Awl/Io/Rw/ViewReadWrite.h"
+#include "Awl/Io/SerializedSize.h"
+#include "Awl/CppStd/Thread.h"
+
+#include <vector>
+#include <span>
+#include <atomic>
+#include <exception>
+#include <algorithm>
+#include <cassert>
+
+//An opt-in encoding of a vector that can be decoded by multiple threads:
+//
+//    the element count;
+//    the number of elements in a chunk, the last chunk can have less;
+//    the chunks, each chunk is its size in bytes followed by its elements.
+//
+//The chunk boundaries are known without parsing the elements, so the chunks are decoded in parallel
+//directly into the slices of the resized vector. The context is used by all the decoding threads concurrently.
+
+namespace awl::io
+{
+    inline constexpr size_t defaultChunkElementCount = 4096;
+
+    template <class Stream, class T, class Allocator, class Context = FakeContext>
+        requires (sequential_output_stream<Stream> && !std::is_same_v<T, bool>)
+    void WriteChunked(Stream & s, const std::vector<T, Allocator> & v, const Context & ctx = {},
+        size_t chunk_element_count = defaultChunkElementCount)
+    {
+        assert(chunk_element_count != 0);
+
+        Write(s, v.size(), ctx);
+        Write(s, chunk_element_count, ctx);
+
+        std::vector<uint8_t> buffer;
+
+        for (size_t first = 0; first < v.size(); first += chunk_element_count)
+        {
+            buffer.clear();
+
+            {
+                VectorOutputStream out(buffer);
+
+                const size_t last = std::min(first + chunk_element_count, v.size());
+
+                for (size_t i = first; i != last; ++i)
+                {
+                    Write(out, v[i], ctx);
+                }
+            }
+
+            Write(s, buffer.size(), ctx);
+
+            s.Write(buffer.data(), buffer.size());
+        }
+    }
+
+    //The VTS Reader builds its read plans lazily while reading, so it cannot be shared by the decoding threads.
+    template <class Stream, class T, class Allocator, class Context = FakeContext>
+        requires (sequential_input_stream<Stream> && !std::is_same_v<T, bool> && !vts_read_context<Context, SpanInputStream, T>)
+    void ReadChunked(Stream & s, std::vector<T, Allocator> & v, const Context & ctx = {},
+        size_t thread_count = DefaultThreadCount())
+    {
+        size_t size;
+        size_t chunk_element_count;
+
+        Read(s, size, ctx);
+        Read(s, chunk_element_count, ctx);
+
+        if (size != 0 && chunk_element_count == 0)
+        {
+            throw CorruptionException();
+        }
+
+        const size_t chunk_count = size == 0 ? 0 : (size - 1) / chunk_element_count + 1;
+
+        //Only an empty element can be written with no bytes, so the element count of a chunk
+        //is bounded by its size before anything is allocated.
+        constexpr size_t minElementSize = std::min<size_t>(FixedSerializedSize<T>().value_or(1), 1);
+
+        //A pinned stream lends the chunks that remain valid after the next call,
+        //a stream that reuses its buffer can lend only one chunk at a time, so the chunks are copied.
+        std::vector<std::span<const uint8_t>> chunks;
+
+        std::vector<std::vector<uint8_t>> buffers;
+
+        for (size_t chunk_index = 0; chunk_index < chunk_count; ++chunk_index)
+        {
+            size_t byte_count;
+
+            Read(s, byte_count, ctx);
+
+            const size_t element_count = std::min(chunk_element_count, size - chunk_index * chunk_element_count);
+
+            if (byte_count < element_count * minElementSize)
+            {
+                throw CorruptionException();
+            }
+
+            const uint8_t* p = nullptr;
+
+            if constexpr (pinned_input_stream<Stream>)
+            {
+                p = BorrowPinned(s, byte_count, 1);
+            }
+
+            if (p != nullptr || byte_count == 0)
+            {
+                chunks.emplace_back(p, byte_count);
+            }
+            else
+            {
+                std::vector<uint8_t> & buffer = buffers.emplace_back();
+
+                //The buffer grows while the data is read, so a corrupted size does not result in a huge allocation.
+                constexpr size_t maxReadSize = 1024 * 1024;
+
+                while (buffer.size() != byte_count)
+                {
+                    const size_t pos = buffer.size();
+
+                    buffer.resize(pos + std::min(byte_count - pos, maxReadSize));
+
+                    ReadRaw(s, buffer.data() + pos, buffer.size() - pos);
+                }
+
+                chunks.emplace_back(buffer);
+            }
+        }
+
+        v.resize(size);
+
+        auto decode = [&v, &ctx, &chunks, size, chunk_element_count](size_t chunk_index)
+        {
+            SpanInputStream in(chunks[chunk_index]);
+
+            const size_t first = chunk_index * chunk_element_count;
+
+            const size_t last = std::min(first + chunk_element_count, size);
+
+            for (size_t i = first; i != last; ++i)
+            {
+                Read(in, v[i], ctx);
+            }
+
+            if (!in.End())
+            {
+                throw CorruptionException();
+            }
+        };
+
+        thread_count = std::min(thread_count, chunk_count);
+
+        if (thread_count <= 1)
+        {
+            for (size_t i = 0; i < chunk_count; ++i)
+            {
+                decode(i);
+            }
+
+            return;
+        }
+
+        std::atomic<size_t> next_chunk = 0;
+
+        std::vector<std::exception_ptr> errors(thread_count);
+
+        auto run = [&decode, &next_chunk, &errors, chunk_count](size_t thread_index)
+        {
+            try
+            {
+                for (size_t i = next_chunk++; i < chunk_count; i = next_chunk++)
+                {
+                    decode(i);
+                }
+            }
+            catch (...)
+            {
+                errors[thread_index] = std::current_exception();
+
+                //Stop the other threads.
+                next_chunk = chunk_count;
+            }
+        };
+
+        {
+            std::vector<std::jthread> threads;
+
+            threads.reserve(thread_count - 1);
+
+            for (size_t i = 1; i < thread_count; ++i)
+            {
+                threads.emplace_back(run, i);
+            }
+
+            //The calling thread also decodes.
+            run(0);
+        }
+
+        for (const std::exception_ptr & error : errors)
+        {
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+}
@@ -8,7 +8,9 @@
 #include "Awl/VectorSet.h"
 #include "Awl/ObservableSet.h"
 #include "Awl/Ring.h"
+#include "Awl/FlatHashMap.h"
 #include "Awl/Io/Rw/RwAdapters.h"
+#include "Awl/Io/Rw/MemoryResource.h"
 
 #include <deque>
 #include <set>
@@ -35,13 +37,15 @@ namespace awl::io
 
         Read(s, count, ctx);
 
+        AdoptMemoryResource(coll, ctx);
+
         for (size_t i = 0; i < count; ++i)
         {
-            typename Coll::value_type elem;
+            auto elem = MakeElement<typename Coll::value_type>(coll);
 
             Read(s, elem, ctx);
 
-            coll.insert(elem);
+            coll.insert(std::move(elem));
         }
     }
 
@@ -53,13 +57,15 @@ namespace awl::io
 
         Read(s, count, ctx);
 
+        AdoptMemoryResource(coll, ctx);
+
         for (size_t i = 0; i < count; ++i)
         {
-            typename Coll::value_type elem;
+            auto elem = MakeElement<typename Coll::value_type>(coll);
 
             Read(s, elem, ctx);
 
-            coll.push_back(elem);
+            coll.push_back(std::move(elem));
         }
     }
 
@@ -72,15 +78,17 @@ namespace awl::io
 
         Read(s, count, ctx);
 
+        AdoptMemoryResource(coll, ctx);
+
         for (size_t i = 0; i < count; ++i)
         {
-            typename Coll::key_type key;
+            auto key = MakeElement<typename Coll::key_type>(coll);
             Read(s, key, ctx);
 
-            typename Coll::mapped_type value;
+            auto value = MakeElement<typename Coll::mapped_type>(coll);
             Read(s, value, ctx);
 
-            coll.insert(std::make_pair(key, value));
+            coll.insert(std::make_pair(std::move(key), std::move(value)));
         }
     }
 
@@ -196,6 +204,34 @@ namespace awl::io
         WriteCollection(s, coll, ctx);
     }
 
+    template<class Stream, class T, class Hash, class KeyEqual, class Allocator, class Context = FakeContext>
+        requires sequential_input_stream<Stream>
+    void Read(Stream & s, flat_hash_set<T, Hash, KeyEqual, Allocator> & coll, const Context & ctx = {})
+    {
+        ReadCollection(s, coll, ctx);
+    }
+
+    template<class Stream, class T, class Hash, class KeyEqual, class Allocator, class Context = FakeContext>
+        requires sequential_output_stream<Stream>
+    void Write(Stream & s, const flat_hash_set<T, Hash, KeyEqual, Allocator> &coll, const Context & ctx = {})
+    {
+        WriteCollection(s, coll, ctx);
+    }
+
+    template<class Stream, class Key, class T, class Hash, class KeyEqual, class Allocator, class Context = FakeContext>
+        requires sequential_input_stream<Stream>
+    void Read(Stream & s, flat_hash_map<Key, T, Hash, KeyEqual, Allocator> & coll, const Context & ctx = {})
+    {
+        ReadMap(s, coll, ctx);
+    }
+
+    template<class Stream, class Key, class T, class Hash, class KeyEqual, class Allocator, class Context = FakeContext>
+        requires sequential_output_stream<Stream>
+    void Write(Stream & s, const flat_hash_map<Key, T, Hash, KeyEqual, Allocator> &coll, const Context & ctx = {})
+    {
+        WriteCollection(s, coll, ctx);
+    }
+
     // awl::ring should be initilized with a limit before it is read.
     template <class Stream, class T, class Alloc, class Context = FakeContext>
         requires sequential_input_stream<Stream>
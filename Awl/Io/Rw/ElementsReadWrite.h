@@ -0,0 +1,121 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Awl/Io/ReadWrite.h"
+#include "Awl/Coro/Generator.h"
+
+#include <ranges>
+#include <vector>
+#include <cstddef>
+
+//A collection of unknown size is written as a sequence of chunks, each chunk is the element count
+//followed by the elements, and the last chunk is empty. The elements are read one at a time,
+//so the collection does not need to fit into the memory.
+
+namespace awl::io
+{
+    inline constexpr size_t defaultElementChunkSize = 1024;
+
+    //The stream should outlive the generator, the context is copied into it.
+    template <class T, class Stream, class Context>
+        requires sequential_input_stream<Stream>
+    generator<T> ReadElements(Stream & s, Context ctx)
+    {
+        while (true)
+        {
+            size_t count;
+
+            Read(s, count, ctx);
+
+            if (count == 0)
+            {
+                co_return;
+            }
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                T val;
+
+                Read(s, val, ctx);
+
+                co_yield val;
+            }
+        }
+    }
+
+    template <class T, class Stream>
+        requires sequential_input_stream<Stream>
+    generator<T> ReadElements(Stream & s)
+    {
+        return ReadElements<T>(s, FakeContext{});
+    }
+
+    //If the size of the range is known, it is written as a single chunk, otherwise up to chunk_size elements
+    //are copied to a buffer to find out the size of the chunk.
+    template <class Stream, std::ranges::input_range Range, class Context = FakeContext>
+        requires sequential_output_stream<Stream>
+    void WriteElements(Stream & s, Range && range, const Context & ctx = {}, size_t chunk_size = defaultElementChunkSize)
+    {
+        const size_t end_of_elements = 0;
+
+        if constexpr (std::ranges::sized_range<Range>)
+        {
+            static_cast<void>(chunk_size);
+
+            const size_t count = static_cast<size_t>(std::ranges::size(range));
+
+            Write(s, count, ctx);
+
+            for (auto && val : range)
+            {
+                Write(s, val, ctx);
+            }
+
+            if (count != 0)
+            {
+                Write(s, end_of_elements, ctx);
+            }
+        }
+        else
+        {
+            assert(chunk_size != 0);
+
+            std::vector<std::ranges::range_value_t<Range>> chunk;
+
+            auto write_chunk = [&s, &ctx, &chunk]()
+            {
+                const size_t count = chunk.size();
+
+                Write(s, count, ctx);
+
+                for (const auto & val : chunk)
+                {
+                    Write(s, val, ctx);
+                }
+
+                chunk.clear();
+            };
+
+            for (auto && val : range)
+            {
+                chunk.push_back(std::forward<decltype(val)>(val));
+
+                if (chunk.size() == chunk_size)
+                {
+                    write_chunk();
+                }
+            }
+
+            if (!chunk.empty())
+            {
+                write_chunk();
+            }
+
+            Write(s, end_of_elements, ctx);
+        }
+    }
+}
@@ -0,0 +1,69 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Awl/Io/SerializationContext.h"
+
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+
+namespace awl::io
+{
+    template <class T>
+    concept pmr_container = requires(const T& t)
+    {
+        typename T::value_type;
+        typename T::allocator_type;
+        { t.empty() } -> std::convertible_to<bool>;
+        { t.get_allocator() } -> std::convertible_to<typename T::allocator_type>;
+    } &&
+        std::is_same_v<typename T::allocator_type, std::pmr::polymorphic_allocator<typename T::value_type>> &&
+        std::is_constructible_v<T, typename T::allocator_type> &&
+        std::is_nothrow_move_constructible_v<T>;
+
+    //The allocator of a pmr container does not propagate on assignment, so an empty container
+    //is recreated in place with the memory resource of the context before it is read.
+    //A non-empty container keeps its memory resource.
+    template <class Container, class Context>
+    void AdoptMemoryResource(Container& val, const Context& ctx)
+    {
+        if constexpr (memory_resource_context<Context> && pmr_container<Container>)
+        {
+            std::pmr::memory_resource* mr = ctx.memory_resource();
+
+            if (mr != nullptr && val.empty() && val.get_allocator().resource() != mr)
+            {
+                Container temp{ typename Container::allocator_type(mr) };
+
+                std::destroy_at(&val);
+
+                std::construct_at(&val, std::move(temp));
+            }
+        }
+        else
+        {
+            static_cast<void>(val);
+            static_cast<void>(ctx);
+        }
+    }
+
+    //Constructs an element with the allocator of the collection, so it is moved into the collection without copying.
+    template <class T, class Coll>
+    T MakeElement(const Coll& coll)
+    {
+        if constexpr (requires { coll.get_allocator(); } && std::uses_allocator_v<T, typename Coll::allocator_type>)
+        {
+            return std::make_obj_using_allocator<T>(coll.get_allocator());
+        }
+        else
+        {
+            static_cast<void>(coll);
+
+            return T{};
+        }
+    }
+}
@@ -0,0 +1,67 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Awl/Tuplizable.h"
+#include "Awl/TupleHelpers.h"
+
+#include <tuple>
+#include <type_traits>
+#include <cstdint>
+
+//A tuplizable structure is packed if its fields are arithmetic types that cover its memory without padding
+//in the order they are listed in as_tuple(). The memory of an array of such structures is the same as its
+//serialized representation, so the array is read and written as a single block.
+
+namespace awl::io
+{
+    template <class T>
+    struct packed_tie : std::false_type
+    {
+        static constexpr size_t size = 0;
+    };
+
+    //sizeof(bool) is implementation-defined, and a bool is written as a byte with the value 0 or 1.
+    template <class... Fields>
+    struct packed_tie<std::tuple<Fields&...>> : std::bool_constant<sizeof...(Fields) != 0 &&
+        ((std::is_arithmetic_v<Fields> && !std::is_same_v<Fields, bool> && !std::is_const_v<Fields>) && ...)>
+    {
+        static constexpr size_t size = (sizeof(Fields) + ... + 0);
+    };
+
+    template <class T>
+    concept packed_tuplizable = is_tuplizable_v<T> && std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T> &&
+        packed_tie<typename tuplizable_traits<T>::Tie>::value && packed_tie<typename tuplizable_traits<T>::Tie>::size == sizeof(T);
+
+    //The fields can be listed in as_tuple() in the order that differs from their declaration,
+    //it can be checked only at runtime.
+    template <class T>
+        requires packed_tuplizable<T>
+    bool HasPackedLayout()
+    {
+        static const bool packed = []()
+        {
+            const T val{};
+
+            const uint8_t* base = reinterpret_cast<const uint8_t*>(&val);
+
+            size_t offset = 0;
+
+            bool result = true;
+
+            for_each(object_as_tuple(val), [base, &offset, &result](const auto& field)
+            {
+                result = result && reinterpret_cast<const uint8_t*>(&field) == base + offset;
+
+                offset += sizeof(field);
+            });
+
+            return result;
+        }();
+
+        return packed;
+    }
+}
@@ -10,6 +10,7 @@
 #include "Awl/Io/SequentialStream.h"
 #include "Awl/DataCast.h"
 
+#include <algorithm>
 #include <cstdint>
 
 namespace awl::io
@@ -30,4 +31,64 @@ namespace awl::io
             throw EndOfFileException(count, actually_read);
         }
     }
+
+    //Returns a pointer to count bytes in the stream's memory or nullptr if the stream can't lend them,
+    //in which case the caller falls back to ReadRaw. A stream that does not declare lendsMemory
+    //is not asked at all, so reading from it costs no extra virtual call.
+    template <class Stream>
+        requires sequential_input_stream<Stream>
+    const uint8_t* TryBorrow(Stream & s, size_t count)
+    {
+        if constexpr (lending_input_stream<Stream>)
+        {
+            return s.Borrow(count);
+        }
+        else
+        {
+            static_cast<void>(s);
+            static_cast<void>(count);
+
+            return nullptr;
+        }
+    }
+
+    //The same as TryBorrow, but the bytes remain in the stream.
+    template <class Stream>
+        requires sequential_input_stream<Stream>
+    const uint8_t* TryPeek(Stream & s, size_t count)
+    {
+        if constexpr (lending_input_stream<Stream>)
+        {
+            return s.Peek(count);
+        }
+        else
+        {
+            static_cast<void>(s);
+            static_cast<void>(count);
+
+            return nullptr;
+        }
+    }
+
+    //Skips count bytes, throws EndOfFileException if the stream ends.
+    template <class Stream>
+        requires sequential_input_stream<Stream>
+    void SkipRaw(Stream & s, size_t count)
+    {
+        if (TryBorrow(s, count) != nullptr)
+        {
+            return;
+        }
+
+        uint8_t buffer[64];
+
+        while (count != 0)
+        {
+            const size_t read_count = std::min(count, sizeof(buffer));
+
+            ReadRaw(s, buffer, read_count);
+
+            count -= read_count;
+        }
+    }
 }
@@ -6,11 +6,13 @@
 #pragma once
 
 #include "Awl/Io/Rw/ReadRaw.h"
+#include "Awl/Io/Rw/MemoryResource.h"
 #include "Awl/Io/IoException.h"
 #include "Awl/StringFormat.h"
 
 #include <string>
 #include <type_traits>
+#include <cstring>
 
 namespace awl::io
 {
@@ -49,6 +51,25 @@ namespace awl::io
 
         CheckStringLimit(ctx, string_length);
 
+        AdoptMemoryResource(val, ctx);
+
+        if (const uint8_t* p = TryBorrow(s, string_length))
+        {
+            if constexpr (sizeof(Char) == 1)
+            {
+                //Assigning from the borrowed buffer does not zero-fill the string first.
+                val.assign(reinterpret_cast<const Char*>(p), len);
+            }
+            else
+            {
+                val.resize(len);
+
+                std::memcpy(val.data(), p, string_length);
+            }
+
+            return;
+        }
+
         val.resize(len);
 
         //There is non-const version of data() since C++ 17.
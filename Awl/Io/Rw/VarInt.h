@@ -0,0 +1,293 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Awl/Io/Rw/ReadRaw.h"
+#include "Awl/Io/IoException.h"
+
+#include <type_traits>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <cstdint>
+
+//The variable length integer encoding used with compact_context: LEB128 for unsigned types
+//and LEB128 of the zigzag encoded value for signed types, so small negative values are also short.
+//Single byte types are not encoded.
+
+namespace awl::io
+{
+    template <class T>
+    concept varint_integral = std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) > 1;
+
+    template <class T>
+    inline constexpr size_t maxVarIntSize = (sizeof(T) * 8 + 6) / 7;
+
+    template <class T>
+        requires varint_integral<T>
+    constexpr std::make_unsigned_t<T> ToVarUnsigned(T val)
+    {
+        using U = std::make_unsigned_t<T>;
+
+        if constexpr (std::is_signed_v<T>)
+        {
+            //Zigzag: 0, -1, 1, -2, 2 ... are mapped to 0, 1, 2, 3, 4 ...
+            return static_cast<U>((static_cast<U>(val) << 1) ^ static_cast<U>(val >> (sizeof(T) * 8 - 1)));
+        }
+        else
+        {
+            return val;
+        }
+    }
+
+    template <class T>
+        requires varint_integral<T>
+    constexpr T FromVarUnsigned(std::make_unsigned_t<T> val)
+    {
+        if constexpr (std::is_signed_v<T>)
+        {
+            return static_cast<T>((val >> 1) ^ (~(val & 1) + 1));
+        }
+        else
+        {
+            return val;
+        }
+    }
+
+    template <class U>
+    constexpr size_t VarIntSize(U val)
+    {
+        return (static_cast<size_t>(std::bit_width(static_cast<U>(val | 1))) + 6) / 7;
+    }
+
+    //The buffer should have maxVarIntSize<U> bytes. Returns the pointer after the written bytes.
+    template <class U>
+    uint8_t* EncodeVarInt(U val, uint8_t* p)
+    {
+        while (val >= 0x80)
+        {
+            *p++ = static_cast<uint8_t>(val | 0x80);
+
+            val >>= 7;
+        }
+
+        *p++ = static_cast<uint8_t>(val);
+
+        return p;
+    }
+
+    //Returns the pointer after the decoded bytes.
+    //Throws CorruptionException if the value is truncated or does not fit into U.
+    template <class U>
+    const uint8_t* DecodeVarInt(const uint8_t* p, const uint8_t* end, U& val)
+    {
+        constexpr unsigned bitCount = sizeof(U) * 8;
+
+        U result = 0;
+
+        for (unsigned shift = 0; ; shift += 7)
+        {
+            if (p == end)
+            {
+                throw CorruptionException();
+            }
+
+            const uint8_t b = *p++;
+
+            //The last possible byte has no continuation bit and only the remaining bits.
+            if (bitCount - shift <= 7 && (b >> (bitCount - shift)) != 0)
+            {
+                throw CorruptionException();
+            }
+
+            result |= static_cast<U>(static_cast<U>(b & 0x7F) << shift);
+
+            if (b < 0x80)
+            {
+                val = result;
+
+                return p;
+            }
+        }
+    }
+
+    //Decodes exactly count values from [p, end).
+    template <class T>
+        requires varint_integral<T>
+    void DecodeVarInts(const uint8_t* p, const uint8_t* end, T* out, size_t count)
+    {
+        using U = std::make_unsigned_t<T>;
+
+        constexpr uint64_t continuationBits = UINT64_C(0x8080808080808080);
+
+        size_t i = 0;
+
+        while (i != count)
+        {
+            //Eight single byte values, that is the usual case for small integers.
+            if (count - i >= 8 && end - p >= 8)
+            {
+                uint64_t word;
+
+                std::memcpy(&word, p, sizeof(word));
+
+                if ((word & continuationBits) == 0)
+                {
+                    for (size_t j = 0; j < 8; ++j)
+                    {
+                        out[i + j] = FromVarUnsigned<T>(static_cast<U>(p[j]));
+                    }
+
+                    p += 8;
+                    i += 8;
+
+                    continue;
+                }
+            }
+
+            U val;
+
+            p = DecodeVarInt(p, end, val);
+
+            out[i++] = FromVarUnsigned<T>(val);
+        }
+
+        if (p != end)
+        {
+            throw CorruptionException();
+        }
+    }
+
+    template <class Stream, class T>
+        requires (sequential_input_stream<Stream> && varint_integral<T>)
+    void ReadVarInt(Stream & s, T & val)
+    {
+        using U = std::make_unsigned_t<T>;
+
+        U u;
+
+        //The value is decoded in the stream's buffer if it has enough bytes, otherwise byte by byte.
+        if (const uint8_t* p = TryPeek(s, maxVarIntSize<T>))
+        {
+            const uint8_t* end = DecodeVarInt(p, p + maxVarIntSize<T>, u);
+
+            TryBorrow(s, static_cast<size_t>(end - p));
+        }
+        else
+        {
+            uint8_t buffer[maxVarIntSize<T>];
+
+            size_t size = 0;
+
+            do
+            {
+                if (size == maxVarIntSize<T>)
+                {
+                    throw CorruptionException();
+                }
+
+                ReadRaw(s, buffer + size, 1);
+            }
+            while (buffer[size++] >= 0x80);
+
+            DecodeVarInt(buffer, buffer + size, u);
+        }
+
+        val = FromVarUnsigned<T>(u);
+    }
+
+    template <class Stream, class T>
+        requires (sequential_output_stream<Stream> && varint_integral<T>)
+    void WriteVarInt(Stream & s, T val)
+    {
+        uint8_t buffer[maxVarIntSize<T>];
+
+        const uint8_t* end = EncodeVarInt(ToVarUnsigned(val), buffer);
+
+        s.Write(buffer, static_cast<size_t>(end - buffer));
+    }
+
+    //The values are preceded by their encoded size, so they are decoded from a single block of memory.
+    template <class Stream, class T>
+        requires (sequential_input_stream<Stream> && varint_integral<T>)
+    void ReadVarInts(Stream & s, T * data, size_t count)
+    {
+        size_t size;
+
+        ReadVarInt(s, size);
+
+        if (size < count || size > count * maxVarIntSize<T>)
+        {
+            throw CorruptionException();
+        }
+
+        if (size == 0)
+        {
+            return;
+        }
+
+        if (const uint8_t* p = TryBorrow(s, size))
+        {
+            DecodeVarInts(p, p + size, data, count);
+        }
+        else
+        {
+            std::vector<uint8_t> buffer(size);
+
+            ReadRaw(s, buffer.data(), size);
+
+            DecodeVarInts(buffer.data(), buffer.data() + size, data, count);
+        }
+    }
+
+    template <class Stream, class T>
+        requires (sequential_output_stream<Stream> && varint_integral<T>)
+    void WriteVarInts(Stream & s, const T * data, size_t count)
+    {
+        size_t size = 0;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            size += VarIntSize(ToVarUnsigned(data[i]));
+        }
+
+        WriteVarInt(s, size);
+
+        //The values are encoded by chunks without allocating the memory.
+        constexpr size_t chunkCount = 256;
+
+        uint8_t buffer[chunkCount * maxVarIntSize<T>];
+
+        for (size_t i = 0; i < count;)
+        {
+            uint8_t* p = buffer;
+
+            for (const size_t chunk_end = std::min(i + chunkCount, count); i != chunk_end; ++i)
+            {
+                p = EncodeVarInt(ToVarUnsigned(data[i]), p);
+            }
+
+            s.Write(buffer, static_cast<size_t>(p - buffer));
+        }
+    }
+
+    template <class Context>
+    constexpr bool IsCompact(const Context & ctx)
+    {
+        if constexpr (compact_context<Context>)
+        {
+            return ctx.compact_integers();
+        }
+        else
+        {
+            static_cast<void>(ctx);
+
+            return false;
+        }
+    }
+}
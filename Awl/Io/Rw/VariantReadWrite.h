@@ -10,115 +10,47 @@
 
 #include <variant>
 #include <type_traits>
+#include <utility>
 #include <cassert>
 
 namespace awl::io
 {
-    namespace impl
+    template <class Stream, typename... Ts, class Context = FakeContext>
+        requires sequential_input_stream<Stream>
+    void Read(Stream & s, std::variant<Ts...> & v, const Context & ctx = {})
     {
-        template <class V, class Stream, class Context>
-        struct VariantAlternativeReader
-        {
-            virtual void ReadAlternative(Stream & in, V & v, const Context & ctx) const = 0;
-        };
+        std::size_t index;
+        Read(s, index, ctx);
 
-        template <class V, class Stream, class Context, size_t index>
-        class VariantAlternativeReaderImpl : public VariantAlternativeReader<V, Stream, Context>
+        const bool found = visit_index<sizeof...(Ts)>(index, [&s, &v, &ctx](auto i)
         {
-        public:
-
-            void ReadAlternative(Stream & in, V & v, const Context & ctx) const override
-            {
-                using T = std::variant_alternative_t<index, V>;
-                
-                T val;
-                Read(in, val, ctx);
-                v = val;
-            }
-        };
-
-        template <class V, class Stream, class Context>
-        class VariantReader
-        {
-        private:
-
-            template <size_t index>
-            using AlternativeReaderImpl = VariantAlternativeReaderImpl<V, Stream, Context, index>;
+            using T = std::variant_alternative_t<i, std::variant<Ts...>>;
 
-        public:
+            //The variant does not change if Read throws.
+            T val;
+            Read(s, val, ctx);
+            v.template emplace<i>(std::move(val));
+        });
 
-            static void ReadVariant(Stream & in, V & v, const Context & ctx)
-            {
-                static auto vrt = transform_v2ti<V, AlternativeReaderImpl>();
-                static auto vra = tuple_cast<VariantAlternativeReader<V, Stream, Context>>(vrt);
-
-                std::size_t index;
-                Read(in, index, ctx);
-
-                assert(index < std::variant_size_v<V>);
-
-                vra[index]->ReadAlternative(in, v, ctx);
-            }
-        };
-
-        template <class V, class Stream, class Context>
-        struct VariantAlternativeWriter
+        if (!found)
         {
-            virtual void WriteAlternative(Stream & out, const V & v, const Context & ctx) const = 0;
-        };
-
-        template <class V, class Stream, class Context, size_t index>
-        class VariantAlternativeWriterImpl : public VariantAlternativeWriter<V, Stream, Context>
-        {
-        public:
-
-            void WriteAlternative(Stream & out, const V & v, const Context & ctx) const override
-            {
-                using T = std::variant_alternative_t<index, V>;
-
-                const T & val = std::get<index>(v);
-                Write(out, val, ctx);
-            }
-        };
-
-        template <class V, class Stream, class Context>
-        class VariantWriter
-        {
-        private:
-
-            template <size_t index>
-            using AlternativeWriterImpl = VariantAlternativeWriterImpl<V, Stream, Context, index>;
-
-        public:
-
-            static void WriteVariant(Stream & out, const V & v, const Context & ctx)
-            {
-                static auto vrt = transform_v2ti<V, AlternativeWriterImpl>();
-                static auto vra = tuple_cast<VariantAlternativeWriter<V, Stream, Context>>(vrt);
-
-                const std::size_t index = v.index();
-                Write(out, index, ctx);
-
-                vra[index]->WriteAlternative(out, v, ctx);
-            }
-        };
-    }
-    
-    template <class Stream, typename... Ts, class Context = FakeContext>
-        requires sequential_input_stream<Stream>
-    void Read(Stream & s, std::variant<Ts...> & v, const Context & ctx = {})
-    {
-        using V = std::variant<Ts...>;
-
-        impl::VariantReader<V, Stream, Context>::ReadVariant(s, v, ctx);
+            throw CorruptionException();
+        }
     }
 
     template <class Stream, typename... Ts, class Context = FakeContext>
         requires sequential_output_stream<Stream>
     void Write(Stream & s, const std::variant<Ts...> & v, const Context & ctx = {})
     {
-        using V = std::variant<Ts...>;
+        const std::size_t index = v.index();
+        Write(s, index, ctx);
+
+        //A variant that is valueless by exception can't be written.
+        [[maybe_unused]] const bool found = visit_index<sizeof...(Ts)>(index, [&s, &v, &ctx](auto i)
+        {
+            Write(s, *std::get_if<i>(&v), ctx);
+        });
 
-        impl::VariantWriter<V, Stream, Context>::WriteVariant(s, v, ctx);
+        assert(found);
     }
 }
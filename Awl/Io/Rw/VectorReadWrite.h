@@ -6,10 +6,15 @@
 #pragma once
 
 #include "Awl/Io/Rw/ReadRaw.h"
+#include "Awl/Io/Rw/VarInt.h"
+#include "Awl/Io/Rw/PackedTuplizable.h"
+#include "Awl/Reflection.h"
+#include "Awl/Io/Rw/MemoryResource.h"
 
 #include <array>
 #include <vector>
 #include <type_traits>
+#include <cstring>
 
 namespace awl::io
 {
@@ -17,15 +22,51 @@ namespace awl::io
         requires (sequential_input_stream<Stream> && std::is_arithmetic<typename Container::value_type>::value && !std::is_same<typename Container::value_type, bool>::value)
     void ReadVector(Stream & s, Container & v, const Context & ctx = {})
     {
-        static_cast<void>(ctx);
-        ReadRaw(s, mutable_data_cast(v.data()), v.size() * sizeof(typename Container::value_type));
+        using T = typename Container::value_type;
+
+        if constexpr (varint_integral<T>)
+        {
+            if (IsCompact(ctx))
+            {
+                ReadVarInts(s, v.data(), v.size());
+
+                return;
+            }
+        }
+
+        const size_t size = v.size() * sizeof(typename Container::value_type);
+
+        if (size == 0)
+        {
+            return;
+        }
+
+        if (const uint8_t* p = TryBorrow(s, size))
+        {
+            std::memcpy(v.data(), p, size);
+        }
+        else
+        {
+            ReadRaw(s, mutable_data_cast(v.data()), size);
+        }
     }
 
     template <class Stream, class Container, class Context = FakeContext>
         requires (sequential_output_stream<Stream> && std::is_arithmetic<typename Container::value_type>::value && !std::is_same<typename Container::value_type, bool>::value)
     void WriteVector(Stream & s, const Container & v, const Context & ctx = {})
     {
-        static_cast<void>(ctx);
+        using T = typename Container::value_type;
+
+        if constexpr (varint_integral<T>)
+        {
+            if (IsCompact(ctx))
+            {
+                WriteVarInts(s, v.data(), v.size());
+
+                return;
+            }
+        }
+
         s.Write(const_data_cast(v.data()), v.size() * sizeof(typename Container::value_type));
     }
 
@@ -34,6 +75,42 @@ namespace awl::io
         requires (sequential_input_stream<Stream> && std::is_class<typename Container::value_type>::value)
     void ReadVector(Stream & s, Container & v, const Context & ctx = {})
     {
+        using T = typename Container::value_type;
+
+        if constexpr (packed_tuplizable<T>)
+        {
+            //Only the reflectable structures are written with the indices.
+            if constexpr (is_reflectable_v<T> && vts_array_read_context<Context, Stream, T>)
+            {
+                ctx.ReadArrayV(s, v.data(), v.size());
+
+                return;
+            }
+            else if constexpr (!vts_read_context<Context, Stream, T>)
+            {
+                if (!IsCompact(ctx) && HasPackedLayout<T>())
+                {
+                    const size_t size = v.size() * sizeof(T);
+
+                    if (size == 0)
+                    {
+                        return;
+                    }
+
+                    if (const uint8_t* p = TryBorrow(s, size))
+                    {
+                        std::memcpy(v.data(), p, size);
+                    }
+                    else
+                    {
+                        ReadRaw(s, reinterpret_cast<uint8_t*>(v.data()), size);
+                    }
+
+                    return;
+                }
+            }
+        }
+
         for (auto & elem : v)
         {
             Read(s, elem, ctx);
@@ -44,6 +121,27 @@ namespace awl::io
         requires (sequential_output_stream<Stream> && std::is_class<typename Container::value_type>::value)
     void WriteVector(Stream & s, const Container & v, const Context & ctx = {})
     {
+        using T = typename Container::value_type;
+
+        if constexpr (packed_tuplizable<T>)
+        {
+            if constexpr (is_reflectable_v<T> && vts_array_write_context<Context, Stream, T>)
+            {
+                ctx.WriteArrayV(s, v.data(), v.size());
+
+                return;
+            }
+            else if constexpr (!vts_write_context<Context, Stream, T>)
+            {
+                if (!IsCompact(ctx) && HasPackedLayout<T>())
+                {
+                    s.Write(reinterpret_cast<const uint8_t*>(v.data()), v.size() * sizeof(T));
+
+                    return;
+                }
+            }
+        }
+
         for (const auto & elem : v)
         {
             Write(s, elem, ctx);
@@ -99,6 +197,8 @@ namespace awl::io
 
         Read(s, size, ctx);
 
+        AdoptMemoryResource(v, ctx);
+
         v.resize(size);
 
         ReadVector(s, v, ctx);
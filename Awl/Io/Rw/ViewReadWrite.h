@@ -0,0 +1,121 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Awl/Io/Rw/ReadRaw.h"
+#include "Awl/Io/Rw/StringReadWrite.h"
+#include "Awl/Io/Rw/VectorReadWrite.h"
+#include "Awl/Io/Rw/VarInt.h"
+#include "Awl/Io/IoException.h"
+
+#include <string_view>
+#include <span>
+#include <limits>
+#include <type_traits>
+#include <cstdint>
+
+//std::basic_string_view and std::span are written as std::basic_string and std::vector, but they are read
+//without copying as the views of the stream's memory. They can be read only from a pinned_input_stream,
+//so the views remain valid while the stream's buffer exists, but not longer.
+
+namespace awl::io
+{
+    template <class Stream>
+        requires pinned_input_stream<Stream>
+    const uint8_t* BorrowPinned(Stream & s, size_t count, size_t alignment)
+    {
+        if (count == 0)
+        {
+            return nullptr;
+        }
+
+        const uint8_t* p = s.Borrow(count);
+
+        if (p == nullptr)
+        {
+            //A pinned stream lends all its remaining bytes.
+            throw EndOfFileException(count, 0);
+        }
+
+        if (reinterpret_cast<uintptr_t>(p) % alignment != 0)
+        {
+            throw IoError(format() << _T("Can't make a view of ") << count << _T(" bytes that are not aligned by ") << alignment << _T("."));
+        }
+
+        return p;
+    }
+
+    template<class Stream, class Char, class Traits = std::char_traits<Char>, class Context = FakeContext>
+        requires (pinned_input_stream<Stream> && std::is_arithmetic_v<Char>)
+    void Read(Stream & s, std::basic_string_view<Char, Traits> & val, const Context & ctx = {})
+    {
+        typename std::basic_string<Char>::size_type len;
+
+        Read(s, len, ctx);
+
+        if (len > std::numeric_limits<size_t>::max() / sizeof(Char))
+        {
+            throw CorruptionException();
+        }
+
+        const size_t string_length = len * sizeof(Char);
+
+        CheckStringLimit(ctx, string_length);
+
+        val = std::basic_string_view<Char, Traits>(reinterpret_cast<const Char*>(BorrowPinned(s, string_length, alignof(Char))), len);
+    }
+
+    template<class Stream, class Char, class Traits = std::char_traits<Char>, class Context = FakeContext>
+        requires (sequential_output_stream<Stream> && std::is_arithmetic_v<Char>)
+    void Write(Stream & s, std::basic_string_view<Char, Traits> val, const Context & ctx = {})
+    {
+        typename std::basic_string<Char>::size_type len = val.length();
+
+        const size_t string_length = len * sizeof(Char);
+
+        CheckStringLimit(ctx, string_length);
+
+        Write(s, len, ctx);
+
+        s.Write(const_data_cast(val.data()), string_length);
+    }
+
+    //The integers written with a compact context are not stored as an array, so they can't be viewed.
+    template <class Stream, class T, class Context = FakeContext>
+        requires (pinned_input_stream<Stream> && std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)
+    void Read(Stream & s, std::span<const T> & val, const Context & ctx = {})
+    {
+        typename std::vector<T>::size_type size;
+
+        Read(s, size, ctx);
+
+        if constexpr (varint_integral<T>)
+        {
+            if (IsCompact(ctx))
+            {
+                throw IoError(format() << _T("Can't make a view of the integers in the compact encoding."));
+            }
+        }
+
+        if (size > std::numeric_limits<size_t>::max() / sizeof(T))
+        {
+            throw CorruptionException();
+        }
+
+        val = std::span<const T>(reinterpret_cast<const T*>(BorrowPinned(s, size * sizeof(T), alignof(T))), size);
+    }
+
+    template <class Stream, class T, class Context = FakeContext>
+        requires (sequential_output_stream<Stream> && std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)
+    void Write(Stream & s, std::span<const T> val, const Context & ctx = {})
+    {
+        typename std::vector<T>::size_type size = val.size();
+
+        Write(s, size, ctx);
+
+        WriteVector(s, val, ctx);
+    }
+}
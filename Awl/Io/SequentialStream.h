@@ -19,6 +19,24 @@ namespace awl::io
 
         virtual size_t Read(uint8_t* buffer, size_t count) = 0;
 
+        //Returns a pointer to the next count bytes in the stream's own memory and moves past them,
+        //or nullptr without consuming anything if the bytes are not available contiguously.
+        //The pointer remains valid until the next call to the stream.
+        virtual const uint8_t* Borrow(size_t count)
+        {
+            static_cast<void>(count);
+
+            return nullptr;
+        }
+
+        //The same as Borrow, but does not move past the bytes.
+        virtual const uint8_t* Peek(size_t count)
+        {
+            static_cast<void>(count);
+
+            return nullptr;
+        }
+
         virtual ~SequentialInputStream() = default;
     };
 
@@ -38,6 +56,30 @@ namespace awl::io
         { t.Read(std::declval<uint8_t*>(), std::declval<size_t>()) } -> std::convertible_to<size_t>;
     };
 
+    //A stream that can lend its internal buffer to avoid copying.
+    template <class T>
+    concept borrowing_input_stream = sequential_input_stream<T> && requires(T& t)
+    {
+        { t.Borrow(std::declval<size_t>()) } -> std::same_as<const uint8_t*>;
+        { t.Peek(std::declval<size_t>()) } -> std::same_as<const uint8_t*>;
+    };
+
+    //A stream that actually overrides Borrow and Peek. SequentialInputStream has them too, but the default
+    //implementations return nullptr, so the readers do not call them through a stream that can't lend.
+    template <class T>
+    concept lending_input_stream = borrowing_input_stream<T> && requires
+    {
+        requires T::lendsMemory;
+    };
+
+    //A stream that lends the memory that does not change while the stream or its underlying buffer exists,
+    //so the borrowed pointers remain valid after the next call to the stream.
+    template <class T>
+    concept pinned_input_stream = lending_input_stream<T> && requires
+    {
+        requires T::pinnedMemory;
+    };
+
     template <class T>
     concept sequential_output_stream = requires(T& t)
     {
@@ -46,4 +88,6 @@ namespace awl::io
 
     static_assert(sequential_input_stream<SequentialInputStream>);
     static_assert(sequential_output_stream<SequentialOutputStream>);
+    static_assert(borrowing_input_stream<SequentialInputStream>);
+    static_assert(!pinned_input_stream<SequentialInputStream>);
 }
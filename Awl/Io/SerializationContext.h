@@ -4,6 +4,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <utility>
+#include <memory_resource>
 
 #pragma once
 
@@ -15,6 +16,21 @@ namespace awl::io
         { std::as_const(t).max_length() } -> std::convertible_to<size_t>;
     };
 
+    //Integers are written in the variable length encoding if compact_integers() returns true.
+    template <class T>
+    concept compact_context = requires(T& t)
+    {
+        { std::as_const(t).compact_integers() } -> std::convertible_to<bool>;
+    };
+
+    //The containers with std::pmr::polymorphic_allocator are read with the memory resource returned by memory_resource(),
+    //a null memory resource is ignored.
+    template <class T>
+    concept memory_resource_context = requires(T& t)
+    {
+        { std::as_const(t).memory_resource() } -> std::convertible_to<std::pmr::memory_resource*>;
+    };
+
     template <class T, class Stream, typename Val>
     concept vts_read_context = requires(T& t)
     {
@@ -27,6 +43,19 @@ namespace awl::io
         { std::as_const(t).WriteV(std::declval<Stream&>(), std::declval<const Val&>()) } -> std::same_as<void>;
     };
 
+    //A VTS context that reads and writes contiguous arrays of structures at once.
+    template <class T, class Stream, typename Val>
+    concept vts_array_read_context = requires(T& t)
+    {
+        { std::as_const(t).template ReadArrayV<Val>(std::declval<Stream&>(), std::declval<Val*>(), size_t{}) } -> std::same_as<void>;
+    };
+
+    template <class T, class Stream, typename Val>
+    concept vts_array_write_context = requires(T& t)
+    {
+        { std::as_const(t).WriteArrayV(std::declval<Stream&>(), std::declval<const Val*>(), size_t{}) } -> std::same_as<void>;
+    };
+
     class FakeContext
     {
     };
@@ -48,4 +77,34 @@ namespace awl::io
     };
 
     static_assert(limited_context<LimitedContext>);
+
+    class CompactContext
+    {
+    public:
+
+        bool compact_integers() const
+        {
+            return true;
+        }
+    };
+
+    static_assert(compact_context<CompactContext>);
+
+    class MemoryResourceContext
+    {
+    public:
+
+        MemoryResourceContext(std::pmr::memory_resource* mr) : m_mr(mr) {}
+
+        std::pmr::memory_resource* memory_resource() const
+        {
+            return m_mr;
+        }
+
+    private:
+
+        std::pmr::memory_resource* m_mr;
+    };
+
+    static_assert(memory_resource_context<MemoryResourceContext>);
 }
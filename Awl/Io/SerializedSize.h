@@ -0,0 +1,115 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Awl/Io/ReadWrite.h"
+#include "Awl/Io/MeasureStream.h"
+#include "Awl/EnumTraits.h"
+#include "Awl/Tuplizable.h"
+
+#include <array>
+#include <tuple>
+#include <optional>
+#include <type_traits>
+
+namespace awl::io
+{
+    template <class T>
+    struct is_std_array : std::false_type {};
+
+    template <class T, std::size_t N>
+    struct is_std_array<std::array<T, N>> : std::true_type {};
+
+    //The size of T written with FakeContext if it does not depend on the value, otherwise std::nullopt.
+    template <class T>
+    constexpr std::optional<size_t> FixedSerializedSize()
+    {
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            return sizeof(uint8_t);
+        }
+        else if constexpr (std::is_arithmetic_v<T>)
+        {
+            return sizeof(T);
+        }
+        else if constexpr (is_nonsequential_enum<T>)
+        {
+            return sizeof(std::underlying_type_t<T>);
+        }
+        else if constexpr (is_std_array<T>::value)
+        {
+            using Element = typename T::value_type;
+
+            constexpr size_t count = std::tuple_size_v<T>;
+
+            if constexpr (std::is_same_v<Element, bool>)
+            {
+                //The bits are packed into bytes.
+                return (count + 7) / 8;
+            }
+            else
+            {
+                constexpr std::optional<size_t> element_size = FixedSerializedSize<Element>();
+
+                if constexpr (element_size.has_value())
+                {
+                    return *element_size * count;
+                }
+                else
+                {
+                    return std::nullopt;
+                }
+            }
+        }
+        else if constexpr (is_tuplizable_v<T>)
+        {
+            return []<class... Fields>(std::type_identity<std::tuple<Fields& ...>>) -> std::optional<size_t>
+            {
+                if constexpr ((FixedSerializedSize<std::remove_cv_t<Fields>>().has_value() && ...))
+                {
+                    return (static_cast<size_t>(0) + ... + *FixedSerializedSize<std::remove_cv_t<Fields>>());
+                }
+                else
+                {
+                    return std::nullopt;
+                }
+            }(std::type_identity<typename tuplizable_traits<T>::Tie>{});
+        }
+        else
+        {
+            return std::nullopt;
+        }
+    }
+
+    template <class T>
+    concept fixed_serialized_size = FixedSerializedSize<T>().has_value();
+
+    template <class T>
+        requires fixed_serialized_size<T>
+    inline constexpr size_t fixedSerializedSize = *FixedSerializedSize<T>();
+
+    //The number of bytes Write(s, val, ctx) writes. It is a constant for a type of fixed size written without a context,
+    //otherwise the value is written to a stream with inlined non-virtual Write that only adds up the sizes.
+    template <class T, class Context = FakeContext>
+    size_t serialized_size(const T & val, const Context & ctx = {})
+    {
+        if constexpr (std::is_same_v<Context, FakeContext> && fixed_serialized_size<T>)
+        {
+            static_cast<void>(val);
+            static_cast<void>(ctx);
+
+            return fixedSerializedSize<T>;
+        }
+        else
+        {
+            StaticMeasureStream out;
+
+            Write(out, val, ctx);
+
+            return out.GetLength();
+        }
+    }
+}
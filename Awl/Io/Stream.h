@@ -8,6 +8,7 @@
 #include "Awl/Io/SequentialStream.h"
 
 #include <cstddef>
+#include <utility>
 
 namespace awl
 {
@@ -44,5 +45,14 @@ namespace awl
         class IoStream : public InputStream, public OutputStream
         {
         };
+
+        //An input stream that can be read at an arbitrary position.
+        template <class T>
+        concept seekable_input_stream = sequential_input_stream<T> && requires(T& t)
+        {
+            t.Seek(std::declval<size_t>());
+            { std::as_const(t).GetPosition() } -> std::convertible_to<size_t>;
+            { std::as_const(t).GetLength() } -> std::convertible_to<size_t>;
+        };
     }
 }
@@ -11,6 +11,8 @@
 #include <vector>
 #include <algorithm>
 #include <iterator>
+#include <span>
+#include <cstring>
 #include <assert.h>
 
 namespace awl 
@@ -21,6 +23,11 @@ namespace awl
         {
         public:
 
+            static constexpr bool lendsMemory = true;
+
+            //The borrowed bytes remain valid while the vector exists and is not modified.
+            static constexpr bool pinnedMemory = true;
+
             VectorInputStream(const std::vector<uint8_t> & v) : m_v(v), m_i(m_v.begin())
             {
             }
@@ -63,6 +70,30 @@ namespace awl
                 return read_count;
             }
 
+            const uint8_t* Borrow(size_t count) override
+            {
+                const uint8_t* p = Peek(count);
+
+                if (p != nullptr)
+                {
+                    m_i += count;
+                }
+
+                return p;
+            }
+
+            const uint8_t* Peek(size_t count) override
+            {
+                const size_t pos = static_cast<size_t>(m_i - m_v.begin());
+
+                if (count > m_v.size() - pos || m_v.empty())
+                {
+                    return nullptr;
+                }
+
+                return m_v.data() + pos;
+            }
+
         private:
 
             const std::vector<uint8_t> & m_v;
@@ -70,6 +101,67 @@ namespace awl
             std::vector<uint8_t>::const_iterator m_i;
         };
 
+        //Reads a block of memory that should outlive the stream.
+        class SpanInputStream : public SequentialInputStream
+        {
+        public:
+
+            static constexpr bool lendsMemory = true;
+
+            static constexpr bool pinnedMemory = true;
+
+            SpanInputStream(std::span<const uint8_t> data) : m_data(data)
+            {
+            }
+
+            bool End() override
+            {
+                return m_pos == m_data.size();
+            }
+
+            size_t Read(uint8_t * buffer, size_t count) override
+            {
+                const size_t read_count = std::min(count, m_data.size() - m_pos);
+
+                if (read_count != 0)
+                {
+                    std::memcpy(buffer, m_data.data() + m_pos, read_count);
+
+                    m_pos += read_count;
+                }
+
+                return read_count;
+            }
+
+            const uint8_t* Borrow(size_t count) override
+            {
+                const uint8_t* p = Peek(count);
+
+                if (p != nullptr)
+                {
+                    m_pos += count;
+                }
+
+                return p;
+            }
+
+            const uint8_t* Peek(size_t count) override
+            {
+                if (count > m_data.size() - m_pos || m_data.empty())
+                {
+                    return nullptr;
+                }
+
+                return m_data.data() + m_pos;
+            }
+
+        private:
+
+            std::span<const uint8_t> m_data;
+
+            size_t m_pos = 0;
+        };
+
         class VectorOutputStream : public SequentialOutputStream
         {
         public:
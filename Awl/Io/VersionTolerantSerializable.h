@@ -8,7 +8,7 @@
 #include "Awl/Io/Serializable.h"
 #include "Awl/Io/Vts.h"
 #include "Awl/Io/VectorStream.h"
-#include "Awl/Io/MeasureStream.h"
+#include "Awl/Io/SerializedSize.h"
 #include "Awl/Io/IoException.h"
 #include "Awl/Mp/Mp.h"
 
@@ -47,13 +47,7 @@ namespace awl::io
 
                     std::vector<uint8_t> v;
 
-                    {
-                        MeasureStream measure_out;
-
-                        io::Write(measure_out, m_val);
-
-                        v.reserve(measure_out.GetLength());
-                    }
+                    v.reserve(serialized_size(m_val));
 
                     // Save old value with a plain serialization.
                     WriteSnapshot(v);
@@ -9,7 +9,16 @@
 #include "Awl/Io/Writer.h"
 #include "Awl/Io/MeasureStream.h"
 #include "Awl/Io/VectorStream.h"
-#include "Awl/Io/MeasureStream.h"
+#include "Awl/Io/FieldMap.h"
+#include "Awl/Reflection.h"
+#include "Awl/TupleHelpers.h"
+
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+#include <string_view>
 
 namespace awl::io
 {
@@ -35,18 +44,20 @@ namespace awl::io
         ctx.WriteV(out, val);
     }
 
+    //The stream type is known at compile time, so the sizes are added up without the virtual calls.
     template <class T, class V = awl::mp::variant_from_struct<T>>
     size_t MeasureV(const T& val)
     {
-        MeasureStream measure_out;
+        StaticMeasureStream measure_out;
 
-        awl::io::WriteV(measure_out, val);
+        awl::io::WriteV<T, StaticMeasureStream, V>(measure_out, val);
 
         return measure_out.GetLength();
     }
 
+    //Converts the object through a buffer with the version tolerant serialization.
     template <class From, class To>
-    void CopyV(const From& from_val, To& to_val)
+    void CopyVBuffered(const From& from_val, To& to_val)
     {
         std::vector<uint8_t> v;
 
@@ -64,4 +75,172 @@ namespace awl::io
             awl::io::ReadV(in, to_val);
         }
     }
+
+    //A field which type has changed is converted as a structure with a single field.
+    template <class T>
+    struct FieldHolder
+    {
+        T value;
+
+        AWL_REFLECT(value)
+    };
+
+    //Maps the fields of To to the fields of From by name, translated with FieldMap<To>, once, then copies or moves the fields of the same type
+    //and converts the nested structures recursively. Only the fields which type has changed are serialized.
+    //Like the VTS Reader, the converter leaves the new fields of To unchanged and ignores the deleted fields of From.
+    template <class From, class To>
+        requires (is_reflectable_v<From> && is_reflectable_v<To>)
+    class VtsConverter
+    {
+    private:
+
+        static constexpr size_t fromCount = std::tuple_size_v<typename tuplizable_traits<From>::Tie>;
+
+        static constexpr size_t toCount = std::tuple_size_v<typename tuplizable_traits<To>::Tie>;
+
+        static constexpr size_t noIndex = awl::helpers::MemberList::NotAnIndex;
+
+        //The indices of the fields of From for each field of To.
+        using Plan = std::array<size_t, toCount>;
+
+    public:
+
+        static void Copy(const From & from_val, To & to_val)
+        {
+            Convert<false>(object_as_const_tuple(from_val), to_val);
+        }
+
+        static void Move(From & from_val, To & to_val)
+        {
+            Convert<true>(object_as_tuple(from_val), to_val);
+        }
+
+    private:
+
+        static const Plan & GetPlan()
+        {
+            static const Plan plan = []()
+            {
+                Plan p;
+
+                p.fill(noIndex);
+
+                const auto & from_names = From::member_names();
+                const auto & to_names = To::member_names();
+
+                for (size_t from_index = 0; from_index < fromCount; ++from_index)
+                {
+                    //The user renamed a field and specialized FieldMap template class, as in Reader::MapPrototypes.
+                    const std::string_view new_name = FieldMap<To>::GetNewName(from_names[from_index]);
+
+                    auto i = std::find(to_names.begin(), to_names.end(), new_name);
+
+                    if (i != to_names.end())
+                    {
+                        p[static_cast<size_t>(i - to_names.begin())] = from_index;
+                    }
+                }
+
+                return p;
+            }();
+
+            return plan;
+        }
+
+        template <bool move, class FromTuple>
+        static void Convert(FromTuple from_tuple, To & to_val)
+        {
+            const Plan & plan = GetPlan();
+
+            auto to_tuple = object_as_tuple(to_val);
+
+            for_each_index(to_tuple, [&from_tuple, &plan](auto & to_field, auto to_index)
+            {
+                const size_t from_index = plan[to_index];
+
+                if (from_index == noIndex)
+                {
+                    return;
+                }
+
+                visit_index<fromCount>(from_index, [&from_tuple, &to_field](auto from_index)
+                {
+                    ConvertField<move>(std::get<from_index>(from_tuple), to_field);
+                });
+            });
+        }
+
+        template <bool move, class F, class T>
+        static void ConvertField(F & from_field, T & to_field)
+        {
+            using FromField = std::remove_cv_t<F>;
+
+            if constexpr (std::is_same_v<FromField, T> && (move ? std::is_move_assignable_v<T> : std::is_copy_assignable_v<T>))
+            {
+                if constexpr (move)
+                {
+                    to_field = std::move(from_field);
+                }
+                else
+                {
+                    to_field = from_field;
+                }
+            }
+            else if constexpr (is_reflectable_v<FromField> && is_reflectable_v<T>)
+            {
+                if constexpr (move)
+                {
+                    VtsConverter<FromField, T>::Move(from_field, to_field);
+                }
+                else
+                {
+                    VtsConverter<FromField, T>::Copy(from_field, to_field);
+                }
+            }
+            else
+            {
+                //The old value is kept in the holder, so the new fields of the nested structures remain unchanged.
+                FieldHolder<T> to_holder{ std::move(to_field) };
+
+                if constexpr (move)
+                {
+                    CopyVBuffered(FieldHolder<FromField>{ std::move(from_field) }, to_holder);
+                }
+                else
+                {
+                    CopyVBuffered(FieldHolder<FromField>{ from_field }, to_holder);
+                }
+
+                to_field = std::move(to_holder.value);
+            }
+        }
+    };
+
+    template <class From, class To>
+    void CopyV(const From& from_val, To& to_val)
+    {
+        if constexpr (is_reflectable_v<From> && is_reflectable_v<To>)
+        {
+            VtsConverter<From, To>::Copy(from_val, to_val);
+        }
+        else
+        {
+            CopyVBuffered(from_val, to_val);
+        }
+    }
+
+    //The same as CopyV, but the fields of the same type are moved.
+    template <class From, class To>
+        requires (!std::is_lvalue_reference_v<From>)
+    void MoveV(From&& from_val, To& to_val)
+    {
+        if constexpr (is_reflectable_v<From> && is_reflectable_v<To>)
+        {
+            VtsConverter<From, To>::Move(from_val, to_val);
+        }
+        else
+        {
+            CopyVBuffered(from_val, to_val);
+        }
+    }
 }
@@ -11,6 +11,9 @@
 #include "Awl/Io/ReadWrite.h"
 
 #include <cassert>
+#include <array>
+#include <algorithm>
+#include <cstring>
 
 namespace awl::io
 {
@@ -62,6 +65,16 @@ namespace awl::io
                 Write(s, index);
             }
 
+            if constexpr (packed_tuplizable<Struct>)
+            {
+                if (CanCopyRaw<Struct>())
+                {
+                    s.Write(reinterpret_cast<const uint8_t*>(&val), sizeof(Struct));
+
+                    return;
+                }
+            }
+
             if constexpr (is_tuplizable_v<Struct>)
             {
                 for_each(object_as_tuple(val), [this, &s](auto& field)
@@ -74,5 +87,54 @@ namespace awl::io
                 Write(s, val, *this);
             }
         }
+
+        //Writes the indices and the structures without calling WriteV for each element.
+        template<class Struct>
+            requires (packed_tuplizable<Struct> && is_reflectable_v<Struct>)
+        void WriteArrayV(OutputStream & s, const Struct * data, size_t count) const
+        {
+            using StructIndexType = typename Base::StructIndexType;
+
+            if (!CanCopyRaw<Struct>())
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    WriteV(s, data[i]);
+                }
+
+                return;
+            }
+
+            const StructIndexType index = static_cast<StructIndexType>(Base::template StructIndex<Struct>);
+
+            constexpr size_t elementSize = sizeof(StructIndexType) + sizeof(Struct);
+
+            constexpr size_t chunkCount = std::max<size_t>(1, 4096 / elementSize);
+
+            std::array<uint8_t, chunkCount * elementSize> buffer;
+
+            for (size_t i = 0; i < count;)
+            {
+                uint8_t* p = buffer.data();
+
+                for (const size_t chunk_end = std::min(i + chunkCount, count); i != chunk_end; ++i, p += elementSize)
+                {
+                    std::memcpy(p, &index, sizeof(index));
+
+                    std::memcpy(p + sizeof(index), data + i, sizeof(Struct));
+                }
+
+                s.Write(buffer.data(), static_cast<size_t>(p - buffer.data()));
+            }
+        }
+
+    private:
+
+        template<class Struct>
+            requires packed_tuplizable<Struct>
+        bool CanCopyRaw() const
+        {
+            return !IsCompact(*this) && HasPackedLayout<Struct>();
+        }
     };
 }
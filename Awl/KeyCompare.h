@@ -8,6 +8,7 @@
 #include "Awl/Tuplizable.h"
 #include "Awl/TypeTraits.h"
 #include "Awl/Getters.h"
+#include "Awl/Hashable.h"
 
 #include <type_traits>
 #include <memory>
@@ -225,6 +226,88 @@ namespace awl
     template <class T, auto value, class Compare = std::less<void>>
     using smart_compare = KeyCompare<T, getter<value>, Compare>;
 
+    //Hashes the elements by their keys, so hash containers can do heterogeneous lookup.
+    template <class T, class GetKey, class Hash = awl::hash<std::remove_cvref_t<std::invoke_result_t<GetKey, const T&>>>>
+    class KeyHash
+    {
+    public:
+
+        using value_type = T;
+
+        using key_type = std::remove_cvref_t<std::invoke_result_t<GetKey, const T&>>;
+
+        KeyHash() = default;
+
+        constexpr KeyHash(GetKey get_key, Hash hash = {}) :
+            getKey(std::move(get_key)),
+            m_hash(std::move(hash))
+        {}
+
+        constexpr size_t operator()(const T& val) const
+        {
+            return m_hash(getKey(val));
+        }
+
+        constexpr size_t operator()(const key_type& id) const
+        {
+            return m_hash(id);
+        }
+
+        using is_transparent = void;
+
+    private:
+
+        GetKey getKey;
+
+        Hash m_hash;
+    };
+
+    template <class T, class GetKey, class Equal = std::equal_to<void>>
+    class KeyEqual
+    {
+    public:
+
+        using value_type = T;
+
+        using key_type = std::remove_cvref_t<std::invoke_result_t<GetKey, const T&>>;
+
+        KeyEqual() = default;
+
+        constexpr KeyEqual(GetKey get_key, Equal equal = {}) :
+            getKey(std::move(get_key)),
+            m_equal(std::move(equal))
+        {}
+
+        constexpr bool operator()(const T& left, const T& right) const
+        {
+            return m_equal(getKey(left), getKey(right));
+        }
+
+        constexpr bool operator()(const T& val, const key_type& id) const
+        {
+            return m_equal(getKey(val), id);
+        }
+
+        constexpr bool operator()(const key_type& id, const T& val) const
+        {
+            return m_equal(id, getKey(val));
+        }
+
+        using is_transparent = void;
+
+    private:
+
+        GetKey getKey;
+
+        Equal m_equal;
+    };
+
+    template <auto value>
+    using member_hash = KeyHash<typename getter<value>::object_type, getter<value>>;
+
+    template <auto value, class Equal = std::equal_to<void>>
+    using member_equal = KeyEqual<typename getter<value>::object_type, getter<value>, Equal>;
+
     // For using with std::ranges::filter without std::bind.
     template <class Field, class Proj>
     class projected_equal_to
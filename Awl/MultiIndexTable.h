@@ -0,0 +1,1127 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Awl/RedBlackTree.h"
+#include "Awl/KeyCompare.h"
+#include "Awl/StringFormat.h"
+#include "Awl/TypeTraits.h"
+
+#include <memory>
+#include <vector>
+#include <tuple>
+#include <utility>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <cstdint>
+#include <bit>
+#include <cassert>
+#include <stdexcept>
+
+namespace awl
+{
+    //Index specifications of multi_index_table. All the indices are unique.
+    //GetKey extracts the key from an element, for example awl::getter<&A::id>.
+
+    //An index ordered by the key.
+    template <class GetKey, class Compare = std::less<>>
+    struct ordered_index
+    {
+        GetKey getKey;
+        Compare comp;
+    };
+
+    //An ordered index that also finds an element by its position and the position of an element with O(logN) time.
+    template <class GetKey, class Compare = std::less<>>
+    struct ranked_index
+    {
+        GetKey getKey;
+        Compare comp;
+    };
+
+    //An index with O(1) lookup by the key, by default it uses std::hash<Key>.
+    template <class GetKey, class Hash = void, class KeyEqual = std::equal_to<>>
+    struct hashed_index
+    {
+        GetKey getKey;
+        Hash hash;
+        KeyEqual equal;
+    };
+
+    template <class GetKey, class KeyEqual>
+    struct hashed_index<GetKey, void, KeyEqual>
+    {
+        GetKey getKey;
+        KeyEqual equal;
+    };
+
+    namespace helpers
+    {
+        //The index links of a table row are the bases of its node, so a row is allocated once
+        //and I makes the link types distinct in the scope of the node.
+        template <class Node, size_t I>
+        struct OrderedIndexLink : public RedBlackLink<OrderedIndexLink<Node, I>>
+        {
+            const auto& value() const
+            {
+                return static_cast<const Node&>(*this).m_val;
+            }
+        };
+
+        template <class Node, size_t I>
+        struct HashedIndexLink
+        {
+            Node* hashNext;
+            std::size_t hashValue;
+        };
+
+        template <class Link, class T>
+        class ordered_index_iterator
+        {
+        private:
+
+            using ListIterator = typename quick_list<Link>::const_iterator;
+
+        public:
+
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const value_type*;
+            using reference = const value_type&;
+
+            ordered_index_iterator() = default;
+
+            ordered_index_iterator(ListIterator i) : m_i(i) {}
+
+            reference operator * () const
+            {
+                return (*m_i)->value();
+            }
+
+            pointer operator -> () const
+            {
+                return &(*m_i)->value();
+            }
+
+            ordered_index_iterator& operator++ ()
+            {
+                ++m_i;
+
+                return *this;
+            }
+
+            ordered_index_iterator operator++ (int)
+            {
+                ordered_index_iterator tmp = *this;
+
+                ++m_i;
+
+                return tmp;
+            }
+
+            ordered_index_iterator& operator-- ()
+            {
+                --m_i;
+
+                return *this;
+            }
+
+            ordered_index_iterator operator-- (int)
+            {
+                ordered_index_iterator tmp = *this;
+
+                --m_i;
+
+                return tmp;
+            }
+
+            bool operator == (const ordered_index_iterator& r) const
+            {
+                return m_i == r.m_i;
+            }
+
+            bool operator != (const ordered_index_iterator& r) const
+            {
+                return !(*this == r);
+            }
+
+            const Link* link() const
+            {
+                return *m_i;
+            }
+
+        private:
+
+            ListIterator m_i;
+        };
+
+        template <class Node, size_t I, class T>
+        class hashed_index_iterator
+        {
+        private:
+
+            using Link = HashedIndexLink<Node, I>;
+
+        public:
+
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const value_type*;
+            using reference = const value_type&;
+
+            hashed_index_iterator() = default;
+
+            hashed_index_iterator(Node* const* p_bucket, Node* const* p_end, const Node* node) :
+                m_pBucket(p_bucket), m_pEnd(p_end), m_node(node)
+            {
+                SkipEmpty();
+            }
+
+            reference operator * () const
+            {
+                return m_node->m_val;
+            }
+
+            pointer operator -> () const
+            {
+                return &m_node->m_val;
+            }
+
+            hashed_index_iterator& operator++ ()
+            {
+                MoveNext();
+
+                return *this;
+            }
+
+            hashed_index_iterator operator++ (int)
+            {
+                hashed_index_iterator tmp = *this;
+
+                MoveNext();
+
+                return tmp;
+            }
+
+            bool operator == (const hashed_index_iterator& r) const
+            {
+                return m_node == r.m_node;
+            }
+
+            bool operator != (const hashed_index_iterator& r) const
+            {
+                return !(*this == r);
+            }
+
+            const Node* node() const
+            {
+                return m_node;
+            }
+
+        private:
+
+            void MoveNext()
+            {
+                assert(m_node != nullptr);
+
+                m_node = static_cast<const Link*>(m_node)->hashNext;
+
+                if (m_node == nullptr)
+                {
+                    ++m_pBucket;
+
+                    SkipEmpty();
+                }
+            }
+
+            //Moves to the first node of the next non-empty bucket if the current node is null.
+            void SkipEmpty()
+            {
+                while (m_node == nullptr && m_pBucket != m_pEnd)
+                {
+                    m_node = *m_pBucket;
+
+                    if (m_node == nullptr)
+                    {
+                        ++m_pBucket;
+                    }
+                }
+            }
+
+            Node* const* m_pBucket = nullptr;
+            Node* const* m_pEnd = nullptr;
+            const Node* m_node = nullptr;
+        };
+
+        template <class T, class Node, size_t I, class GetKey, class Compare>
+        class OrderedIndexImpl
+        {
+        protected:
+
+            using Link = OrderedIndexLink<Node, I>;
+            using ValueCompare = KeyCompare<T, GetKey, Compare>;
+            using Tree = RedBlackTree<Link, T, ValueCompare>;
+            using List = quick_list<Link>;
+
+        public:
+
+            using value_type = T;
+            using size_type = std::size_t;
+            using key_compare = ValueCompare;
+
+            using iterator = ordered_index_iterator<Link, T>;
+            using const_iterator = iterator;
+
+            //The position where a new node is inserted.
+            using Position = Link*;
+
+            explicit OrderedIndexImpl(ordered_index<GetKey, Compare> spec) : m_tree(ValueCompare(std::move(spec.getKey), std::move(spec.comp)))
+            {
+            }
+
+            explicit OrderedIndexImpl(ranked_index<GetKey, Compare> spec) : m_tree(ValueCompare(std::move(spec.getKey), std::move(spec.comp)))
+            {
+            }
+
+            //Copies the comparer, but not the elements.
+            OrderedIndexImpl(const OrderedIndexImpl& other) : m_tree(other.m_tree.m_comp)
+            {
+            }
+
+            OrderedIndexImpl(OrderedIndexImpl&& other) noexcept : m_tree(std::move(other.m_tree))
+            {
+                other.m_tree.m_root = nullptr;
+            }
+
+            OrderedIndexImpl& operator = (OrderedIndexImpl&& other) noexcept
+            {
+                m_tree = std::move(other.m_tree);
+                other.m_tree.m_root = nullptr;
+                return *this;
+            }
+
+            size_type size() const
+            {
+                return m_tree.size();
+            }
+
+            bool empty() const
+            {
+                return m_tree.empty();
+            }
+
+            const_iterator begin() const { return m_tree.m_list.begin(); }
+            const_iterator end() const { return m_tree.m_list.end(); }
+
+            const T& front() const { return m_tree.m_list.front()->value(); }
+            const T& back() const { return m_tree.m_list.back()->value(); }
+
+            template <class Key>
+            const_iterator find(const Key& key) const
+            {
+                return LinkToIterator(m_tree.FindNodeByKey(key));
+            }
+
+            template <class Key>
+            bool contains(const Key& key) const
+            {
+                return m_tree.FindNodeByKey(key) != nullptr;
+            }
+
+            template <class Key>
+            const_iterator lower_bound(const Key& key) const
+            {
+                return LinkToIterator(std::get<0>(m_tree.FindBoundByKey(key)));
+            }
+
+            template <class Key>
+            const_iterator upper_bound(const Key& key) const
+            {
+                auto [link, equal] = m_tree.FindBoundByKey(key);
+
+                if (equal)
+                {
+                    return ++LinkToIterator(link);
+                }
+
+                return LinkToIterator(link);
+            }
+
+            key_compare key_comp() const
+            {
+                return m_tree.m_comp;
+            }
+
+        protected:
+
+            //Returns the existing node with the same key or nullptr and the insert position.
+            const Node* FindConflict(const T& val, Position& pos) const
+            {
+                Link* link = m_tree.FindNodeByKey(val, &pos);
+
+                return link != nullptr ? static_cast<const Node*>(link) : nullptr;
+            }
+
+            void LinkNode(Node* node, Position pos)
+            {
+                m_tree.InsertNode(static_cast<Link*>(node), pos);
+            }
+
+            //The node is excluded from the list in its destructor.
+            void UnlinkNode(Node* node)
+            {
+                m_tree.RemoveNode(static_cast<Link*>(node));
+            }
+
+            //Destroys all the nodes in the order of this index.
+            template <class Destroy>
+            void DestroyNodes(Destroy&& destroy)
+            {
+                while (!m_tree.m_list.empty())
+                {
+                    destroy(static_cast<Node*>(m_tree.m_list.front()));
+                }
+            }
+
+            void Reset()
+            {
+                m_tree.m_root = nullptr;
+            }
+
+            void Reserve(size_type)
+            {
+            }
+
+            const_iterator NodeToIterator(const Node* node) const
+            {
+                return const_iterator(typename List::const_iterator(static_cast<const Link*>(node)));
+            }
+
+            static const Node* IteratorToNode(const_iterator i)
+            {
+                return static_cast<const Node*>(i.link());
+            }
+
+            const_iterator LinkToIterator(const Link* link) const
+            {
+                if (link != nullptr)
+                {
+                    return const_iterator(typename List::const_iterator(link));
+                }
+
+                return end();
+            }
+
+            Tree m_tree;
+        };
+
+        template <class T, class Node, size_t I, class GetKey, class Compare>
+        class RankedIndexImpl : public OrderedIndexImpl<T, Node, I, GetKey, Compare>
+        {
+        private:
+
+            using Base = OrderedIndexImpl<T, Node, I, GetKey, Compare>;
+
+        public:
+
+            using typename Base::size_type;
+            using typename Base::const_iterator;
+
+            using Base::Base;
+
+            const T& operator[](size_type pos) const
+            {
+                return this->m_tree.FindNodeByIndex(pos)->value();
+            }
+
+            const T& at(size_type pos) const
+            {
+                if (!(pos < this->size()))
+                {
+                    throw std::out_of_range(aformat() << "Index " << pos << " is out of range [0, " << this->size() << "].");
+                }
+
+                return (*this)[pos];
+            }
+
+            //With size() and greater it returns end().
+            const_iterator find_by_index(size_type pos) const
+            {
+                return this->LinkToIterator(this->m_tree.FindNodeByIndex(pos));
+            }
+
+            size_type index_of(const_iterator i) const
+            {
+                return this->m_tree.IndexOfNode(i.link());
+            }
+
+            template <class Key>
+            size_type index_of(const Key& key) const
+            {
+                auto [link, index] = this->m_tree.FindIndexByKey(key);
+
+                if (link == nullptr)
+                {
+                    throw std::out_of_range("Key not found.");
+                }
+
+                return index;
+            }
+        };
+
+        template <class T, class Node, size_t I, class GetKey, class Hash, class KeyEqual>
+        class HashedIndexImpl
+        {
+        protected:
+
+            using Link = HashedIndexLink<Node, I>;
+            using Key = std::remove_cvref_t<std::invoke_result_t<GetKey, const T&>>;
+            using Hasher = std::conditional_t<std::is_void_v<Hash>, std::hash<Key>, Hash>;
+            using BucketVector = std::vector<Node*>;
+
+        public:
+
+            using value_type = T;
+            using size_type = std::size_t;
+            using hasher = Hasher;
+            using key_equal = KeyEqual;
+
+            using iterator = hashed_index_iterator<Node, I, T>;
+            using const_iterator = iterator;
+
+            struct Position
+            {
+                std::size_t hashValue;
+                size_type bucket;
+            };
+
+            explicit HashedIndexImpl(hashed_index<GetKey, Hash, KeyEqual> spec) : m_getKey(std::move(spec.getKey)), m_equal(std::move(spec.equal))
+            {
+                if constexpr (!std::is_void_v<Hash>)
+                {
+                    m_hash = std::move(spec.hash);
+                }
+            }
+
+            //Copies the hash and the key equality functions, but not the elements.
+            HashedIndexImpl(const HashedIndexImpl& other) : m_getKey(other.m_getKey), m_hash(other.m_hash), m_equal(other.m_equal)
+            {
+            }
+
+            HashedIndexImpl(HashedIndexImpl&& other) noexcept :
+                m_getKey(std::move(other.m_getKey)),
+                m_hash(std::move(other.m_hash)),
+                m_equal(std::move(other.m_equal)),
+                m_buckets(std::move(other.m_buckets)),
+                m_shift(other.m_shift),
+                m_count(other.m_count)
+            {
+                other.Reset();
+            }
+
+            HashedIndexImpl& operator = (HashedIndexImpl&& other) noexcept
+            {
+                m_getKey = std::move(other.m_getKey);
+                m_hash = std::move(other.m_hash);
+                m_equal = std::move(other.m_equal);
+                m_buckets = std::move(other.m_buckets);
+                m_shift = other.m_shift;
+                m_count = other.m_count;
+                other.Reset();
+                return *this;
+            }
+
+            size_type size() const
+            {
+                return m_count;
+            }
+
+            bool empty() const
+            {
+                return m_count == 0;
+            }
+
+            const_iterator begin() const
+            {
+                return const_iterator(m_buckets.data(), m_buckets.data() + m_buckets.size(), nullptr);
+            }
+
+            const_iterator end() const
+            {
+                return const_iterator();
+            }
+
+            template <class K>
+            const_iterator find(const K& key) const
+            {
+                return NodeToIterator(FindNode(key, m_hash(key)));
+            }
+
+            template <class K>
+            bool contains(const K& key) const
+            {
+                return FindNode(key, m_hash(key)) != nullptr;
+            }
+
+            size_type bucket_count() const
+            {
+                return m_buckets.size();
+            }
+
+            hasher hash_function() const
+            {
+                return m_hash;
+            }
+
+            key_equal key_eq() const
+            {
+                return m_equal;
+            }
+
+        protected:
+
+            const Node* FindConflict(const T& val, Position& pos) const
+            {
+                pos.hashValue = m_hash(m_getKey(val));
+                pos.bucket = BucketIndex(pos.hashValue);
+
+                return FindNode(m_getKey(val), pos.hashValue);
+            }
+
+            void LinkNode(Node* node, Position pos)
+            {
+                Link* link = static_cast<Link*>(node);
+
+                link->hashValue = pos.hashValue;
+                link->hashNext = m_buckets[pos.bucket];
+                m_buckets[pos.bucket] = node;
+
+                ++m_count;
+            }
+
+            void UnlinkNode(Node* node)
+            {
+                Node** p_next = &m_buckets[BucketIndex(static_cast<Link*>(node)->hashValue)];
+
+                while (*p_next != node)
+                {
+                    assert(*p_next != nullptr);
+                    p_next = &static_cast<Link*>(*p_next)->hashNext;
+                }
+
+                *p_next = static_cast<Link*>(node)->hashNext;
+
+                --m_count;
+            }
+
+            template <class Destroy>
+            void DestroyNodes(Destroy&& destroy)
+            {
+                for (Node*& head : m_buckets)
+                {
+                    while (head != nullptr)
+                    {
+                        Node* next = static_cast<Link*>(head)->hashNext;
+                        destroy(head);
+                        head = next;
+                    }
+                }
+            }
+
+            void Reset()
+            {
+                std::fill(m_buckets.begin(), m_buckets.end(), nullptr);
+                m_count = 0;
+            }
+
+            //Guarantees that the positions found for new_size elements remain valid, so it is called before FindConflict.
+            void Reserve(size_type new_size)
+            {
+                if (new_size > m_buckets.size())
+                {
+                    Rehash(m_buckets.empty() ? initialBucketCount : m_buckets.size() * 2);
+                }
+            }
+
+            const_iterator NodeToIterator(const Node* node) const
+            {
+                if (node != nullptr)
+                {
+                    const size_type bucket = BucketIndex(static_cast<const Link*>(node)->hashValue);
+
+                    return const_iterator(m_buckets.data() + bucket, m_buckets.data() + m_buckets.size(), node);
+                }
+
+                return end();
+            }
+
+            static const Node* IteratorToNode(const_iterator i)
+            {
+                return i.node();
+            }
+
+        private:
+
+            static constexpr size_type initialBucketCount = 16;
+
+            template <class K>
+            const Node* FindNode(const K& key, std::size_t hash_value) const
+            {
+                if (m_buckets.empty())
+                {
+                    return nullptr;
+                }
+
+                for (const Node* node = m_buckets[BucketIndex(hash_value)]; node != nullptr; node = static_cast<const Link*>(node)->hashNext)
+                {
+                    const Link* link = static_cast<const Link*>(node);
+
+                    if (link->hashValue == hash_value && m_equal(m_getKey(node->m_val), key))
+                    {
+                        return node;
+                    }
+                }
+
+                return nullptr;
+            }
+
+            //Fibonacci hashing spreads the bits of weak hash functions like std::hash<int> over the buckets.
+            size_type BucketIndex(std::size_t hash_value) const
+            {
+                return static_cast<size_type>((static_cast<uint64_t>(hash_value) * UINT64_C(0x9E3779B97F4A7C15)) >> m_shift);
+            }
+
+            void Rehash(size_type new_bucket_count)
+            {
+                BucketVector old_buckets(new_bucket_count, nullptr);
+
+                m_buckets.swap(old_buckets);
+
+                m_shift = 64 - std::countr_zero(new_bucket_count);
+
+                for (Node* head : old_buckets)
+                {
+                    while (head != nullptr)
+                    {
+                        Link* link = static_cast<Link*>(head);
+                        Node* next = link->hashNext;
+
+                        Node*& new_head = m_buckets[BucketIndex(link->hashValue)];
+                        link->hashNext = new_head;
+                        new_head = head;
+
+                        head = next;
+                    }
+                }
+            }
+
+            GetKey m_getKey;
+            Hasher m_hash;
+            KeyEqual m_equal;
+
+            BucketVector m_buckets;
+            int m_shift = 64;
+            size_type m_count = 0;
+        };
+
+        template <class Node, size_t I, class Spec>
+        struct index_traits;
+
+        template <class Node, size_t I, class GetKey, class Compare>
+        struct index_traits<Node, I, ordered_index<GetKey, Compare>>
+        {
+            using Link = OrderedIndexLink<Node, I>;
+
+            template <class T>
+            using Impl = OrderedIndexImpl<T, Node, I, GetKey, Compare>;
+        };
+
+        template <class Node, size_t I, class GetKey, class Compare>
+        struct index_traits<Node, I, ranked_index<GetKey, Compare>>
+        {
+            using Link = OrderedIndexLink<Node, I>;
+
+            template <class T>
+            using Impl = RankedIndexImpl<T, Node, I, GetKey, Compare>;
+        };
+
+        template <class Node, size_t I, class GetKey, class Hash, class KeyEqual>
+        struct index_traits<Node, I, hashed_index<GetKey, Hash, KeyEqual>>
+        {
+            using Link = HashedIndexLink<Node, I>;
+
+            template <class T>
+            using Impl = HashedIndexImpl<T, Node, I, GetKey, Hash, KeyEqual>;
+        };
+    }
+
+    //Stores each element once in a node that contains the links of all the indices,
+    //so an insertion or a deletion updates all the indices in one pass without notifications.
+    //This is an alternative to observable_set with mirror_set or foreign_set observers that keep their own copies.
+    template <class T, class... Indexes>
+    class multi_index_table
+    {
+    private:
+
+        static_assert(sizeof...(Indexes) != 0, "A table should have at least one index.");
+
+        static constexpr size_t indexCount = sizeof...(Indexes);
+
+        using IndexSequence = std::make_index_sequence<indexCount>;
+
+        struct Node;
+
+        template <size_t I>
+        using Spec = std::tuple_element_t<I, std::tuple<Indexes...>>;
+
+        template <size_t I>
+        using Traits = helpers::index_traits<Node, I, Spec<I>>;
+
+        template <class Sequence>
+        struct NodeLinks;
+
+        template <size_t... I>
+        struct NodeLinks<std::index_sequence<I...>> : public Traits<I>::Link...
+        {
+        };
+
+        //The node can be constructed even if there already is an element with the same key in one of the indices,
+        //in which case it is destroyed immediately.
+        struct Node : public NodeLinks<IndexSequence>
+        {
+            template <class... Args>
+            Node(Args&&... args) : NodeLinks<IndexSequence>{}, m_val(std::forward<Args>(args) ...)
+            {
+            }
+
+            T m_val;
+        };
+
+        template <size_t I>
+        struct IndexImpl : public Traits<I>::template Impl<T>
+        {
+            using Base = typename Traits<I>::template Impl<T>;
+
+            using Base::Base;
+
+            friend multi_index_table;
+        };
+
+        template <class Sequence>
+        struct IndexTupleCreator;
+
+        template <size_t... I>
+        struct IndexTupleCreator<std::index_sequence<I...>>
+        {
+            using Type = std::tuple<IndexImpl<I>...>;
+        };
+
+        using IndexTuple = typename IndexTupleCreator<IndexSequence>::Type;
+
+        using NodeAllocator = std::allocator<Node>;
+
+        template <class Iterator, class Sequence>
+        struct IteratorMatcher;
+
+        template <class Iterator, size_t... I>
+        struct IteratorMatcher<Iterator, std::index_sequence<I...>>
+        {
+            static constexpr bool value = (std::is_same_v<Iterator, typename IndexImpl<I>::const_iterator> || ...);
+        };
+
+        template <class Iterator>
+        static constexpr bool is_iterator = IteratorMatcher<Iterator, IndexSequence>::value;
+
+    public:
+
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = const value_type&;
+        using const_reference = const value_type&;
+
+        template <size_t I>
+        using index_type = IndexImpl<I>;
+
+        using iterator = typename index_type<0>::const_iterator;
+        using const_iterator = iterator;
+
+        multi_index_table() : multi_index_table(Indexes{}...)
+        {
+        }
+
+        explicit multi_index_table(Indexes... indexes) : m_indexes(std::move(indexes)...)
+        {
+        }
+
+        multi_index_table(std::initializer_list<value_type> init) : multi_index_table(init, Indexes{}...)
+        {
+        }
+
+        multi_index_table(std::initializer_list<value_type> init, Indexes... indexes) : multi_index_table(std::move(indexes)...)
+        {
+            for (const value_type& val : init)
+            {
+                insert(val);
+            }
+        }
+
+        multi_index_table(const multi_index_table& other) : m_indexes(other.m_indexes)
+        {
+            CopyElements(other);
+        }
+
+        multi_index_table(multi_index_table&& other) noexcept : m_indexes(std::move(other.m_indexes)), m_size(other.m_size)
+        {
+            other.m_size = 0;
+        }
+
+        ~multi_index_table()
+        {
+            clear();
+        }
+
+        multi_index_table& operator = (const multi_index_table& other)
+        {
+            if (this != &other)
+            {
+                *this = multi_index_table(other);
+            }
+
+            return *this;
+        }
+
+        multi_index_table& operator = (multi_index_table&& other) noexcept
+        {
+            if (this != &other)
+            {
+                clear();
+                m_indexes = std::move(other.m_indexes);
+                m_size = other.m_size;
+                other.m_size = 0;
+            }
+
+            return *this;
+        }
+
+        template <size_t I>
+        const index_type<I>& get() const
+        {
+            return std::get<I>(m_indexes);
+        }
+
+        const_iterator begin() const { return get<0>().begin(); }
+        const_iterator end() const { return get<0>().end(); }
+
+        template <class Key>
+        const_iterator find(const Key& key) const
+        {
+            return get<0>().find(key);
+        }
+
+        template <class Key>
+        bool contains(const Key& key) const
+        {
+            return get<0>().contains(key);
+        }
+
+        bool empty() const
+        {
+            return m_size == 0;
+        }
+
+        size_type size() const
+        {
+            return m_size;
+        }
+
+        //If an element with the same key exists in any of the indices, the element is not inserted
+        //and the returned iterator points to the existing element.
+        std::pair<iterator, bool> insert(const value_type& val)
+        {
+            return emplace(val);
+        }
+
+        std::pair<iterator, bool> insert(value_type&& val)
+        {
+            return emplace(std::move(val));
+        }
+
+        template <class... Args>
+        std::pair<iterator, bool> emplace(Args&&... args)
+        {
+            NodeHolder holder(CreateNode(std::forward<Args>(args) ...), NodeDeleter{ this });
+
+            return InsertNode(std::move(holder), IndexSequence{});
+        }
+
+        //Accepts an iterator of any index.
+        template <class Iterator>
+            requires is_iterator<Iterator>
+        void erase(Iterator i)
+        {
+            EraseNode(IteratorToNode(i));
+        }
+
+        //Returns the number of removed elements.
+        template <size_t I, class Key>
+        size_type erase(const Key& key)
+        {
+            auto& index = std::get<I>(m_indexes);
+
+            auto i = index.find(key);
+
+            if (i != index.end())
+            {
+                EraseNode(index.IteratorToNode(i));
+                return 1;
+            }
+
+            return 0;
+        }
+
+        template <class Key>
+            requires (!is_iterator<Key>)
+        size_type erase(const Key& key)
+        {
+            return erase<0>(key);
+        }
+
+        void clear()
+        {
+            if (m_size != 0)
+            {
+                std::get<0>(m_indexes).DestroyNodes([this](Node* node) { DestroyNode(node); });
+
+                std::apply([](auto&... index) { (index.Reset(), ...); }, m_indexes);
+
+                m_size = 0;
+            }
+        }
+
+        bool operator == (const multi_index_table& other) const
+        {
+            return size() == other.size() && std::equal(begin(), end(), other.begin());
+        }
+
+        bool operator != (const multi_index_table& other) const
+        {
+            return !operator == (other);
+        }
+
+    private:
+
+        Node* CreateNode(auto&&... args)
+        {
+            Node* node = m_nodeAlloc.allocate(1);
+
+            try
+            {
+                new (node) Node(std::forward<decltype(args)>(args) ...);
+            }
+            catch (...)
+            {
+                m_nodeAlloc.deallocate(node, 1);
+                throw;
+            }
+
+            return node;
+        }
+
+        void DestroyNode(Node* node)
+        {
+            node->~Node();
+            m_nodeAlloc.deallocate(node, 1);
+        }
+
+        struct NodeDeleter
+        {
+            multi_index_table* owner;
+
+            void operator()(Node* node) const noexcept
+            {
+                if (node != nullptr)
+                {
+                    owner->DestroyNode(node);
+                }
+            }
+        };
+
+        using NodeHolder = std::unique_ptr<Node, NodeDeleter>;
+
+        //Finds the insert positions in all the indices first, so nothing is changed if there is a duplicate key.
+        template <size_t... I>
+        std::pair<iterator, bool> InsertNode(NodeHolder holder, std::index_sequence<I...>)
+        {
+            (std::get<I>(m_indexes).Reserve(m_size + 1), ...);
+
+            std::tuple<typename IndexImpl<I>::Position...> positions;
+
+            const Node* existing = nullptr;
+
+            static_cast<void>((((existing = std::get<I>(m_indexes).FindConflict(holder->m_val, std::get<I>(positions))) == nullptr) && ...));
+
+            if (existing != nullptr)
+            {
+                return std::make_pair(std::get<0>(m_indexes).NodeToIterator(existing), false);
+            }
+
+            Node* node = holder.release();
+
+            (std::get<I>(m_indexes).LinkNode(node, std::get<I>(positions)), ...);
+
+            ++m_size;
+
+            return std::make_pair(std::get<0>(m_indexes).NodeToIterator(node), true);
+        }
+
+        template <class Iterator, size_t I = 0>
+        static const Node* IteratorToNode(Iterator i)
+        {
+            if constexpr (std::is_same_v<Iterator, typename IndexImpl<I>::const_iterator>)
+            {
+                return IndexImpl<I>::IteratorToNode(i);
+            }
+            else if constexpr (I + 1 < indexCount)
+            {
+                return IteratorToNode<Iterator, I + 1>(i);
+            }
+            else
+            {
+                static_assert(dependent_false_v<Iterator>, "Not an iterator of this table.");
+            }
+        }
+
+        void EraseNode(const Node* const_node)
+        {
+            //The iterators are constant because the keys can't be modified.
+            Node* node = const_cast<Node*>(const_node);
+
+            std::apply([node](auto&... index) { (index.UnlinkNode(node), ...); }, m_indexes);
+
+            DestroyNode(node);
+
+            --m_size;
+        }
+
+        void CopyElements(const multi_index_table& other)
+        {
+            for (const T& val : other)
+            {
+                insert(val);
+            }
+        }
+
+        IndexTuple m_indexes;
+
+        size_type m_size = 0;
+
+        NodeAllocator m_nodeAlloc;
+    };
+}
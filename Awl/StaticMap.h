@@ -15,6 +15,8 @@
 #include <stdexcept>
 #include <regex>
 #include <ranges>
+#include <cctype>
+#include <cstdint>
 
 namespace awl
 {
@@ -51,6 +53,11 @@ namespace awl
 
         const StaticLink<T>* find(const char* name) const
         {
+            if (frozen())
+            {
+                return frozen_find(name);
+            }
+
             return internal_find(m_links, name);
         }
 
@@ -59,6 +66,35 @@ namespace awl
             return find(name.c_str());
         }
 
+        //Builds a perfect hash index over the case-folded names, so find() does a single comparison.
+        //The map should not be modified after that.
+        void freeze()
+        {
+            m_slots.clear();
+            m_seeds.clear();
+
+            size_t slot_count = 1;
+
+            while (slot_count * 4 < m_links.size() * 5)
+            {
+                slot_count *= 2;
+            }
+
+            //If the index can't be built (theoretically possible with equal hashes), find() does a binary search.
+            for (size_t i = 0; !m_links.empty() && i < maxGrowCount; ++i, slot_count *= 2)
+            {
+                if (try_freeze(slot_count))
+                {
+                    return;
+                }
+            }
+        }
+
+        bool frozen() const
+        {
+            return !m_slots.empty();
+        }
+
         template <class Pred = true_predicate<T>>
         static StaticMap fill(const std::string& name_filter = {}, Pred&& value_filter = {})
         {
@@ -113,7 +149,7 @@ namespace awl
         {
             auto i = std::lower_bound(links.begin(), links.end(), name, less_comp());
 
-            if (i == links.end() || !equal_comp()((*i)->name(), name))
+            if (i == links.end() || StrCmpI((*i)->name(), name) != 0)
             {
                 return nullptr;
             }
@@ -121,8 +157,161 @@ namespace awl
             return *i;
         }
 
+        static constexpr uint32_t maxSeedCount = 1u << 16;
+
+        static constexpr size_t maxGrowCount = 8;
+
+        static constexpr size_t emptySlot = static_cast<size_t>(-1);
+
+        //Case-insensitive FNV-1a.
+        static uint64_t hash(const char* name)
+        {
+            uint64_t h = 14695981039346656037ull;
+
+            for (const char* p = name; *p != 0; ++p)
+            {
+                h ^= static_cast<uint8_t>(std::tolower(static_cast<unsigned char>(*p)));
+                h *= 1099511628211ull;
+            }
+
+            return h;
+        }
+
+        //The hash is displaced with the seed of its bucket and mixed with MurmurHash3 finalizer.
+        static size_t slot_index(uint64_t h, uint32_t seed, size_t mask)
+        {
+            h ^= (static_cast<uint64_t>(seed) + 1) * 0x9E3779B97F4A7C15ull;
+
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdull;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ull;
+            h ^= h >> 33;
+
+            return static_cast<size_t>(h) & mask;
+        }
+
+        //Hash and displace: the names are distributed over the buckets, and starting from the largest bucket
+        //we search for a seed that places all the names of the bucket into free slots.
+        bool try_freeze(size_t slot_count)
+        {
+            const size_t bucket_count = std::max<size_t>(slot_count / 4, 1);
+            const size_t mask = slot_count - 1;
+
+            std::vector<uint64_t> hashes(m_links.size());
+            std::vector<std::vector<size_t>> buckets(bucket_count);
+
+            for (size_t i = 0; i < m_links.size(); ++i)
+            {
+                hashes[i] = hash(m_links[i]->name());
+
+                buckets[hashes[i] % bucket_count].push_back(i);
+            }
+
+            std::vector<size_t> order(bucket_count);
+
+            for (size_t i = 0; i < bucket_count; ++i)
+            {
+                order[i] = i;
+            }
+
+            std::ranges::stable_sort(order, std::greater<>{}, [&buckets](size_t b) { return buckets[b].size(); });
+
+            m_slots.assign(slot_count, emptySlot);
+            m_seeds.assign(bucket_count, 0);
+
+            std::vector<size_t> taken;
+
+            for (size_t b : order)
+            {
+                const std::vector<size_t>& bucket = buckets[b];
+
+                uint32_t seed = 0;
+
+                for (; seed < maxSeedCount; ++seed)
+                {
+                    taken.clear();
+
+                    for (size_t i : bucket)
+                    {
+                        const size_t slot = slot_index(hashes[i], seed, mask);
+
+                        if (m_slots[slot] != emptySlot)
+                        {
+                            break;
+                        }
+
+                        m_slots[slot] = i;
+
+                        taken.push_back(slot);
+                    }
+
+                    if (taken.size() == bucket.size())
+                    {
+                        break;
+                    }
+
+                    for (size_t slot : taken)
+                    {
+                        m_slots[slot] = emptySlot;
+                    }
+                }
+
+                if (seed == maxSeedCount)
+                {
+                    m_slots.clear();
+                    m_seeds.clear();
+
+                    return false;
+                }
+
+                m_seeds[b] = seed;
+            }
+
+            return true;
+        }
+
+        const StaticLink<T>* frozen_find(const char* name) const
+        {
+            const uint64_t h = hash(name);
+
+            const size_t index = m_slots[slot_index(h, m_seeds[h % m_seeds.size()], m_slots.size() - 1)];
+
+            if (index == emptySlot)
+            {
+                return nullptr;
+            }
+
+            const StaticLink<T>* p_link = m_links[index];
+
+            return StrCmpI(p_link->name(), name) == 0 ? p_link : nullptr;
+        }
+
         explicit StaticMap(LinkVector links) : m_links(std::move(links)) {}
 
         LinkVector m_links;
+
+        //Perfect hash index, indices of the links or emptySlot.
+        std::vector<size_t> m_slots;
+
+        //Per bucket seeds.
+        std::vector<uint32_t> m_seeds;
     };
+
+    //Built at first use from all the links of the static chain, so it should not be called
+    //during the static initialization.
+    template <class T>
+    const StaticMap<T>& frozen_static_map()
+    {
+        static const StaticMap<T> map = []()
+        {
+            StaticMap<T> m = StaticMap<T>::fill();
+
+            m.freeze();
+
+            return m;
+        }();
+
+        return map;
+    }
 }
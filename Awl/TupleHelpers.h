@@ -206,6 +206,24 @@ namespace awl
         return tuple_to_array(t, std::forward<Func>(f), std::index_sequence_for<Args...>{});
     }
 
+    //Calls f(std::integral_constant<std::size_t, i>()) with the compile time constant equal to i,
+    //returns false if there is no such index. The compiler turns the fold expression into a jump table
+    //and inlines the calls.
+    template <typename Func, std::size_t... index>
+    constexpr bool visit_index(std::size_t i, Func&& f, std::index_sequence<index...>)
+    {
+        static_cast<void>(i);
+        static_cast<void>(f);
+
+        return ((i == index && (f(std::integral_constant<std::size_t, index>()), true)) || ...);
+    }
+
+    template <std::size_t N, typename Func>
+    constexpr bool visit_index(std::size_t i, Func&& f)
+    {
+        return visit_index(i, std::forward<Func>(f), std::make_index_sequence<N>());
+    }
+
     //Get the index of the single unique match for an arbitrary type in something tuple-like:
     template <class T, class U, std::size_t... index>
     static constexpr auto find_tuple_type_impl(std::index_sequence<index...>) noexcept
@@ -0,0 +1,243 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Awl/Io/MappedStream.h"
+#include "Awl/Io/BufferedStream.h"
+#include "Awl/Io/ParallelHashStream.h"
+#include "Awl/Io/Vts.h"
+
+#include "Awl/String.h"
+#include "Awl/ScopeGuard.h"
+#include "Awl/StopWatch.h"
+#include "Awl/Reflection.h"
+#include "Awl/Crypto/Crc64.h"
+
+#include "Awl/Testing/UnitTest.h"
+
+#include "Tests/Helpers/BenchmarkHelpers.h"
+
+#include <filesystem>
+#include <numeric>
+
+using namespace awl::testing;
+
+namespace
+{
+    const awl::Char file_name[] = _T("mapped.dat");
+
+    void RemoveFile()
+    {
+        std::filesystem::remove(file_name);
+    }
+
+    struct Sample
+    {
+        int id;
+        std::vector<int64_t> values;
+        std::string name;
+
+        AWL_REFLECT(id, values, name)
+    };
+
+    AWL_MEMBERWISE_EQUATABLE(Sample)
+
+    Sample MakeSample(size_t element_count)
+    {
+        Sample sample{ 5, std::vector<int64_t>(element_count), "sample" };
+
+        std::iota(sample.values.begin(), sample.values.end(), 0);
+
+        return sample;
+    }
+
+    void WriteSample(const Sample& sample)
+    {
+        awl::io::UniqueStream s(awl::io::CreateUniqueFile(file_name));
+
+        awl::io::WriteV(s, sample);
+    }
+}
+
+AWL_TEST(MappedStream)
+{
+    AWL_UNUSED_CONTEXT;
+
+    auto guard = awl::make_scope_guard(RemoveFile);
+
+    const std::vector<uint8_t> sample = {'A', 'B', 'C', 'D', 'E'};
+
+    {
+        awl::io::UniqueStream s(awl::io::CreateUniqueFile(file_name));
+
+        s.Write(sample.data(), sample.size());
+    }
+
+    awl::io::MappedInputStream in(file_name);
+
+    AWL_ASSERT_EQUAL(sample.size(), in.GetLength());
+    AWL_ASSERT_EQUAL(static_cast<size_t>(0), in.GetPosition());
+    AWL_ASSERT(std::ranges::equal(sample, in.GetData()));
+
+    std::vector<uint8_t> actual(3);
+
+    AWL_ASSERT_EQUAL(actual.size(), in.Read(actual.data(), actual.size()));
+    AWL_ASSERT(std::ranges::equal(sample | std::views::take(3), actual));
+    AWL_ASSERT_FALSE(in.End());
+
+    //Only the remaining bytes are read.
+    AWL_ASSERT_EQUAL(static_cast<size_t>(2), in.Read(actual.data(), actual.size()));
+    AWL_ASSERT(actual[0] == 'D' && actual[1] == 'E');
+    AWL_ASSERT(in.End());
+
+    in.Seek(1);
+    in.Move(2);
+
+    AWL_ASSERT_EQUAL(static_cast<size_t>(3), in.GetPosition());
+
+    try
+    {
+        in.Move(3);
+
+        AWL_FAILM("Moved out of the mapped region.");
+    }
+    catch (const awl::io::IoException&)
+    {
+    }
+}
+
+AWL_TEST(MappedStreamEmpty)
+{
+    AWL_UNUSED_CONTEXT;
+
+    auto guard = awl::make_scope_guard(RemoveFile);
+
+    {
+        awl::io::UniqueStream s(awl::io::CreateUniqueFile(file_name));
+    }
+
+    awl::io::MappedInputStream in(file_name, awl::io::MapAdvice::WillNeed);
+
+    AWL_ASSERT(in.End());
+    AWL_ASSERT(in.GetData().empty());
+
+    uint8_t byte;
+
+    AWL_ASSERT_EQUAL(static_cast<size_t>(0), in.Read(&byte, 1));
+}
+
+AWL_TEST(MappedStreamReadV)
+{
+    AWL_UNUSED_CONTEXT;
+
+    auto guard = awl::make_scope_guard(RemoveFile);
+
+    const Sample expected = MakeSample(1000);
+
+    WriteSample(expected);
+
+    for (auto advice : { awl::io::MapAdvice::Normal, awl::io::MapAdvice::Sequential, awl::io::MapAdvice::WillNeed, awl::io::MapAdvice::Random })
+    {
+        awl::io::MappedInputStream in(file_name, advice);
+
+        Sample actual;
+
+        awl::io::ReadV(in, actual);
+
+        AWL_ASSERT(actual == expected);
+        AWL_ASSERT(in.End());
+    }
+}
+
+AWL_TEST(MappedStreamParallelHash)
+{
+    AWL_UNUSED_CONTEXT;
+
+    auto guard = awl::make_scope_guard(RemoveFile);
+
+    const Sample expected = MakeSample(100000);
+
+    const size_t block_size = 1000;
+
+    {
+        awl::io::UniqueStream s(awl::io::CreateUniqueFile(file_name));
+
+        awl::io::HashOutputStream<awl::crypto::Crc64> out(s, block_size);
+
+        awl::io::WriteV(out, expected);
+    }
+
+    awl::io::MappedInputStream in(file_name);
+
+    //The blocks are verified in parallel directly in the mapped memory.
+    awl::io::ParallelHashInputStream<awl::crypto::Crc64> hash_in(in.GetData(), block_size);
+
+    Sample actual;
+
+    awl::io::ReadV(hash_in, actual);
+
+    AWL_ASSERT(actual == expected);
+    AWL_ASSERT(hash_in.End());
+}
+
+AWL_BENCHMARK(MappedStreamLoad)
+{
+    AWL_ATTRIBUTE(size_t, element_count, 10000000);
+    AWL_ATTRIBUTE(size_t, iteration_count, 10);
+
+    auto guard = awl::make_scope_guard(RemoveFile);
+
+    const Sample expected = MakeSample(element_count);
+
+    WriteSample(expected);
+
+    const size_t size = awl::io::MeasureV(expected) * iteration_count;
+
+    auto test = [&](const awl::Char* name, auto&& read)
+    {
+        awl::StopWatch w;
+
+        for (size_t i = 0; i < iteration_count; ++i)
+        {
+            Sample actual;
+
+            read(actual);
+
+            AWL_ASSERT(actual.values.size() == expected.values.size());
+        }
+
+        context.logger.debug(name);
+        helpers::ReportSpeed(context, w, size);
+    };
+
+    test(_T("Native stream: "), [](Sample& actual)
+    {
+        awl::io::UniqueStream in(awl::io::OpenUniqueFile(file_name));
+
+        awl::io::ReadV(in, actual);
+    });
+
+    test(_T("BufferedInputStream over native stream: "), [](Sample& actual)
+    {
+        awl::io::UniqueStream in(awl::io::OpenUniqueFile(file_name));
+
+        awl::io::BufferedInputStream buffered_in(in);
+
+        awl::io::ReadV(buffered_in, actual);
+    });
+
+    test(_T("MappedInputStream (sequential): "), [](Sample& actual)
+    {
+        awl::io::MappedInputStream in(file_name, awl::io::MapAdvice::Sequential);
+
+        awl::io::ReadV(in, actual);
+    });
+
+    test(_T("MappedInputStream (willneed): "), [](Sample& actual)
+    {
+        awl::io::MappedInputStream in(file_name, awl::io::MapAdvice::WillNeed);
+
+        awl::io::ReadV(in, actual);
+    });
+}
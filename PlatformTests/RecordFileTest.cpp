@@ -0,0 +1,231 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Awl/Io/RecordFile.h"
+#include "Awl/Io/MappedStream.h"
+
+#include "Awl/String.h"
+#include "Awl/ScopeGuard.h"
+#include "Awl/StopWatch.h"
+#include "Awl/Random.h"
+#include "Awl/Reflection.h"
+
+#include "Awl/Testing/UnitTest.h"
+
+#include "Tests/Helpers/BenchmarkHelpers.h"
+
+#include <filesystem>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace awl::testing;
+
+namespace
+{
+    const awl::Char file_name[] = _T("records.dat");
+
+    void RemoveFile()
+    {
+        std::filesystem::remove(file_name);
+    }
+
+    struct Record
+    {
+        int64_t id;
+        std::string name;
+        std::vector<double> values;
+
+        AWL_REFLECT(id, name, values)
+    };
+
+    AWL_MEMBERWISE_EQUATABLE(Record)
+
+    //A newer version of Record with reordered and added fields.
+    struct RecordV2
+    {
+        int64_t id;
+        std::vector<double> values;
+        int32_t flags = 7;
+        std::string name;
+
+        AWL_REFLECT(id, values, flags, name)
+    };
+
+    Record MakeRecord(size_t i)
+    {
+        return Record{ static_cast<int64_t>(i), "record " + std::to_string(i), std::vector<double>(i % 10, static_cast<double>(i)) };
+    }
+
+    void WriteRecords(size_t count)
+    {
+        awl::io::UniqueStream s(awl::io::CreateUniqueFile(file_name));
+
+        awl::io::RecordFileWriter<Record, awl::io::UniqueStream> writer(s);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            writer.Write(MakeRecord(i));
+        }
+
+        writer.Finish();
+    }
+
+    template <class IStream>
+    void TestRecordFile(IStream& in, size_t count)
+    {
+        awl::io::RecordFileReader<Record, IStream> reader(in);
+
+        AWL_ASSERT_EQUAL(count, reader.GetCount());
+
+        std::uniform_int_distribution<size_t> dist(0, count - 1);
+
+        for (size_t i = 0; i < 100; ++i)
+        {
+            const size_t index = dist(awl::random());
+
+            AWL_ASSERT(reader.ReadRecord(index) == MakeRecord(index));
+        }
+
+        const std::vector<Record> range = reader.ReadRange(count / 2, count / 4);
+
+        for (size_t i = 0; i < range.size(); ++i)
+        {
+            AWL_ASSERT(range[i] == MakeRecord(count / 2 + i));
+        }
+
+        size_t index = 0;
+
+        for (const Record& val : reader)
+        {
+            AWL_ASSERT(val == MakeRecord(index++));
+        }
+
+        AWL_ASSERT_EQUAL(count, index);
+
+        try
+        {
+            reader.ReadRecord(count);
+
+            AWL_FAILM("IoError is not thrown.");
+        }
+        catch (const awl::io::IoError&)
+        {
+        }
+    }
+}
+
+AWL_TEST(RecordFile)
+{
+    AWL_ATTRIBUTE(size_t, element_count, 1000);
+
+    auto guard = awl::make_scope_guard(RemoveFile);
+
+    WriteRecords(element_count);
+
+    {
+        awl::io::MappedInputStream in(file_name, awl::io::MapAdvice::Random);
+
+        TestRecordFile(in, element_count);
+    }
+
+    {
+        awl::io::UniqueStream in(awl::io::OpenUniqueFile(file_name));
+
+        TestRecordFile(in, element_count);
+    }
+
+    //The records are read through the Reader context, so the version can change.
+    {
+        awl::io::MappedInputStream in(file_name);
+
+        awl::io::RecordFileReader<RecordV2, awl::io::MappedInputStream> reader(in);
+
+        const RecordV2 val = reader.ReadRecord(element_count - 1);
+
+        const Record expected = MakeRecord(element_count - 1);
+
+        AWL_ASSERT(val.id == expected.id && val.values == expected.values && val.flags == 7 && val.name == expected.name);
+    }
+}
+
+AWL_TEST(RecordFileEmpty)
+{
+    AWL_UNUSED_CONTEXT;
+
+    auto guard = awl::make_scope_guard(RemoveFile);
+
+    WriteRecords(0);
+
+    awl::io::MappedInputStream in(file_name);
+
+    awl::io::RecordFileReader<Record, awl::io::MappedInputStream> reader(in);
+
+    AWL_ASSERT_EQUAL(size_t(0), reader.GetCount());
+    AWL_ASSERT(reader.begin() == reader.end());
+    AWL_ASSERT(reader.ReadRange(0, 0).empty());
+}
+
+AWL_TEST(RecordFileCorruption)
+{
+    AWL_UNUSED_CONTEXT;
+
+    auto guard = awl::make_scope_guard(RemoveFile);
+
+    WriteRecords(10);
+
+    //The footer is lost.
+    std::filesystem::resize_file(file_name, std::filesystem::file_size(file_name) - 1);
+
+    awl::io::MappedInputStream in(file_name);
+
+    try
+    {
+        awl::io::RecordFileReader<Record, awl::io::MappedInputStream> reader(in);
+
+        AWL_FAILM("CorruptionException is not thrown.");
+    }
+    catch (const awl::io::CorruptionException&)
+    {
+    }
+}
+
+//./AwlTest --filter RecordFileRandomAccess.* --output all --element_count 10000000
+AWL_BENCHMARK(RecordFileRandomAccess)
+{
+    AWL_ATTRIBUTE(size_t, element_count, 100000);
+    AWL_ATTRIBUTE(size_t, read_count, 100000);
+
+    auto guard = awl::make_scope_guard(RemoveFile);
+
+    {
+        awl::StopWatch w;
+
+        WriteRecords(element_count);
+
+        context.logger.debug(_T("Write: "));
+
+        helpers::ReportCount(context, w, element_count);
+    }
+
+    awl::io::MappedInputStream in(file_name, awl::io::MapAdvice::Random);
+
+    awl::io::RecordFileReader<Record, awl::io::MappedInputStream> reader(in);
+
+    std::uniform_int_distribution<size_t> dist(0, element_count - 1);
+
+    awl::StopWatch w;
+
+    Record val;
+
+    for (size_t i = 0; i < read_count; ++i)
+    {
+        reader.ReadRecord(dist(awl::random()), val);
+    }
+
+    context.logger.debug(_T("Random read: "));
+
+    helpers::ReportCount(context, w, read_count);
+}
@@ -0,0 +1,180 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Awl/Io/NativeStream.h"
+
+#include <sys/mman.h>
+
+#include <span>
+#include <cstring>
+#include <cstddef>
+
+namespace awl::io
+{
+    //How the mapped pages are going to be accessed.
+    enum class MapAdvice
+    {
+        Normal,
+        Sequential,
+        WillNeed,
+        Random
+    };
+
+    //A read-only memory mapped file. Read() copies directly from the mapped pages without a system call,
+    //Borrow() lends them without copying and GetData() exposes the whole mapped region.
+    class MappedInputStream : public InputStream
+    {
+    public:
+
+        static constexpr bool lendsMemory = true;
+
+        //The borrowed bytes remain valid while the stream exists.
+        static constexpr bool pinnedMemory = true;
+
+        MappedInputStream(const String& file_name, MapAdvice advice = MapAdvice::Sequential) :
+            MappedInputStream(OpenUniqueFile(file_name), advice)
+        {
+        }
+
+        MappedInputStream(UniqueFileHandle&& h, MapAdvice advice = MapAdvice::Sequential)
+        {
+            struct stat sb;
+
+            if (::fstat(h, &sb) == -1)
+            {
+                throw PosixException("::fstat failed.");
+            }
+
+            m_size = static_cast<size_t>(sb.st_size);
+
+            //An empty file can't be mapped.
+            if (m_size != 0)
+            {
+                void* p = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, h, 0);
+
+                if (p == MAP_FAILED)
+                {
+                    throw PosixException("::mmap failed.");
+                }
+
+                m_data = static_cast<const uint8_t*>(p);
+
+                //The advice is only a hint, so its failure is not an error.
+                ::madvise(p, m_size, ToNative(advice));
+            }
+
+            //The mapping remains valid after the file is closed.
+        }
+
+        MappedInputStream(const MappedInputStream&) = delete;
+
+        MappedInputStream& operator = (const MappedInputStream&) = delete;
+
+        ~MappedInputStream()
+        {
+            if (m_data != nullptr)
+            {
+                ::munmap(const_cast<uint8_t*>(m_data), m_size);
+            }
+        }
+
+        std::span<const uint8_t> GetData() const
+        {
+            return std::span<const uint8_t>(m_data, m_size);
+        }
+
+        bool End() override
+        {
+            return m_pos == m_size;
+        }
+
+        size_t Read(uint8_t* buffer, size_t count) override
+        {
+            const size_t read_count = std::min(count, m_size - m_pos);
+
+            if (read_count != 0)
+            {
+                std::memcpy(buffer, m_data + m_pos, read_count);
+
+                m_pos += read_count;
+            }
+
+            return read_count;
+        }
+
+        const uint8_t* Borrow(size_t count) override
+        {
+            const uint8_t* p = Peek(count);
+
+            if (p != nullptr)
+            {
+                m_pos += count;
+            }
+
+            return p;
+        }
+
+        const uint8_t* Peek(size_t count) override
+        {
+            if (m_data == nullptr || count > m_size - m_pos)
+            {
+                return nullptr;
+            }
+
+            return m_data + m_pos;
+        }
+
+        size_t GetLength() const override
+        {
+            return m_size;
+        }
+
+        size_t GetPosition() const override
+        {
+            return m_pos;
+        }
+
+        void Seek(std::size_t pos, bool begin = true) override
+        {
+            SetPosition(begin ? pos : m_size + pos);
+        }
+
+        void Move(std::ptrdiff_t offset) override
+        {
+            SetPosition(m_pos + offset);
+        }
+
+    private:
+
+        void SetPosition(size_t pos)
+        {
+            if (pos > m_size)
+            {
+                throw IoError(format() << _T("Position ") << pos << _T(" is out of the mapped region of ") << m_size << _T(" bytes."));
+            }
+
+            m_pos = pos;
+        }
+
+        static int ToNative(MapAdvice advice)
+        {
+            switch (advice)
+            {
+                case MapAdvice::Sequential: return MADV_SEQUENTIAL;
+                case MapAdvice::WillNeed: return MADV_WILLNEED;
+                case MapAdvice::Random: return MADV_RANDOM;
+                default: return MADV_NORMAL;
+            }
+        }
+
+        const uint8_t* m_data = nullptr;
+
+        size_t m_size = 0;
+
+        size_t m_pos = 0;
+    };
+}
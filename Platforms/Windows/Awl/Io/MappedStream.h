@@ -0,0 +1,179 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Awl/Io/NativeStream.h"
+
+#include <span>
+#include <cstring>
+#include <cstddef>
+
+namespace awl::io
+{
+    //How the mapped pages are going to be accessed.
+    enum class MapAdvice
+    {
+        Normal,
+        Sequential,
+        WillNeed,
+        Random
+    };
+
+    //A read-only memory mapped file. Read() copies directly from the mapped pages without a system call,
+    //Borrow() lends them without copying and GetData() exposes the whole mapped region.
+    class MappedInputStream : public InputStream
+    {
+    public:
+
+        static constexpr bool lendsMemory = true;
+
+        //The borrowed bytes remain valid while the stream exists.
+        static constexpr bool pinnedMemory = true;
+
+        MappedInputStream(const String& file_name, MapAdvice advice = MapAdvice::Sequential) :
+            MappedInputStream(OpenUniqueFile(file_name), advice)
+        {
+        }
+
+        MappedInputStream(UniqueFileHandle&& h, MapAdvice advice = MapAdvice::Sequential)
+        {
+            LARGE_INTEGER li;
+
+            if (::GetFileSizeEx(h, &li) == FALSE)
+            {
+                throw Win32Exception(_T("::GetFileSizeEx failed."));
+            }
+
+            m_size = static_cast<size_t>(li.QuadPart);
+
+            //An empty file can't be mapped.
+            if (m_size != 0)
+            {
+                UniqueHandle<nullptr> mapping = ::CreateFileMappingW(h, NULL, PAGE_READONLY, 0, 0, NULL);
+
+                if (!mapping)
+                {
+                    throw Win32Exception(_T("::CreateFileMapping failed."));
+                }
+
+                const void* p = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+                if (p == NULL)
+                {
+                    throw Win32Exception(_T("::MapViewOfFile failed."));
+                }
+
+                m_data = static_cast<const uint8_t*>(p);
+
+                //There is no direct equivalent of the other hints, Windows detects the sequential access itself.
+                if (advice == MapAdvice::WillNeed)
+                {
+                    WIN32_MEMORY_RANGE_ENTRY entry{ const_cast<void*>(p), m_size };
+
+                    ::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &entry, 0);
+                }
+            }
+
+            //The view remains valid after the file and the mapping object are closed.
+        }
+
+        MappedInputStream(const MappedInputStream&) = delete;
+
+        MappedInputStream& operator = (const MappedInputStream&) = delete;
+
+        ~MappedInputStream()
+        {
+            if (m_data != nullptr)
+            {
+                ::UnmapViewOfFile(m_data);
+            }
+        }
+
+        std::span<const uint8_t> GetData() const
+        {
+            return std::span<const uint8_t>(m_data, m_size);
+        }
+
+        bool End() override
+        {
+            return m_pos == m_size;
+        }
+
+        size_t Read(uint8_t* buffer, size_t count) override
+        {
+            const size_t read_count = std::min(count, m_size - m_pos);
+
+            if (read_count != 0)
+            {
+                std::memcpy(buffer, m_data + m_pos, read_count);
+
+                m_pos += read_count;
+            }
+
+            return read_count;
+        }
+
+        const uint8_t* Borrow(size_t count) override
+        {
+            const uint8_t* p = Peek(count);
+
+            if (p != nullptr)
+            {
+                m_pos += count;
+            }
+
+            return p;
+        }
+
+        const uint8_t* Peek(size_t count) override
+        {
+            if (m_data == nullptr || count > m_size - m_pos)
+            {
+                return nullptr;
+            }
+
+            return m_data + m_pos;
+        }
+
+        size_t GetLength() const override
+        {
+            return m_size;
+        }
+
+        size_t GetPosition() const override
+        {
+            return m_pos;
+        }
+
+        void Seek(std::size_t pos, bool begin = true) override
+        {
+            SetPosition(begin ? pos : m_size + pos);
+        }
+
+        void Move(std::ptrdiff_t offset) override
+        {
+            SetPosition(m_pos + offset);
+        }
+
+    private:
+
+        void SetPosition(size_t pos)
+        {
+            if (pos > m_size)
+            {
+                throw IoError(format() << _T("Position ") << pos << _T(" is out of the mapped region of ") << m_size << _T(" bytes."));
+            }
+
+            m_pos = pos;
+        }
+
+        const uint8_t* m_data = nullptr;
+
+        size_t m_size = 0;
+
+        size_t m_pos = 0;
+    };
+}
@@ -0,0 +1,289 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Awl/Io/Rw/ChunkedReadWrite.h"
+#include "Awl/Io/VectorStream.h"
+#include "Awl/Io/HashStream.h"
+#include "Awl/Crypto/Crc64.h"
+
+#include "Awl/StopWatch.h"
+#include "Awl/StringFormat.h"
+#include "Awl/Testing/UnitTest.h"
+
+#include "Tests/Helpers/BenchmarkHelpers.h"
+#include "Tests/Helpers/NonBorrowingInputStream.h"
+#include "Tests/VtsTestCommon.h"
+
+#include <vector>
+#include <string>
+#include <thread>
+#include <cstring>
+#include <limits>
+
+using namespace awl::testing;
+
+namespace
+{
+    namespace vts_data = awl::testing::helpers;
+
+    using awl::testing::helpers::NonBorrowingInputStream;
+
+    template <class T, class Context = awl::io::FakeContext>
+    void TestChunked(const std::vector<T>& sample, size_t chunk_element_count, const Context& ctx = {})
+    {
+        std::vector<uint8_t> v;
+
+        {
+            awl::io::VectorOutputStream out(v);
+
+            awl::io::WriteChunked(out, sample, ctx, chunk_element_count);
+            awl::io::WriteChunked(out, sample, ctx, chunk_element_count);
+        }
+
+        for (size_t thread_count : { 1, 2, 5 })
+        {
+            {
+                awl::io::VectorInputStream in(v);
+
+                for (size_t i = 0; i < 2; ++i)
+                {
+                    std::vector<T> result;
+
+                    awl::io::ReadChunked(in, result, ctx, thread_count);
+
+                    AWL_ASSERT(result == sample);
+                }
+
+                AWL_ASSERT(in.End());
+            }
+
+            {
+                NonBorrowingInputStream in(v);
+
+                std::vector<T> result;
+
+                awl::io::ReadChunked(in, result, ctx, thread_count);
+
+                AWL_ASSERT(result == sample);
+            }
+        }
+    }
+
+    template <class Stream, class T, class Context>
+    concept chunked_readable = requires(Stream & s, std::vector<T>& v, const Context & ctx)
+    {
+        awl::io::ReadChunked(s, v, ctx);
+    };
+
+    //The VTS Reader is not thread safe, so it is rejected.
+    static_assert(chunked_readable<awl::io::SequentialInputStream, vts_data::v1::B, awl::io::FakeContext>);
+    static_assert(!chunked_readable<awl::io::SequentialInputStream, vts_data::v1::B,
+        awl::testing::vts_common::OldReader<awl::io::SequentialInputStream>>);
+}
+
+AWL_TEST(ChunkedReadWrite)
+{
+    AWL_UNUSED_CONTEXT;
+
+    for (size_t size : { 0, 1, 7, 100, 1000 })
+    {
+        std::vector<std::string> strings;
+        std::vector<int64_t> ints;
+        std::vector<vts_data::v1::B> structs;
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            strings.push_back(std::to_string(i));
+            ints.push_back(static_cast<int64_t>(i) - 500);
+            structs.push_back(vts_data::v1::b_expected);
+        }
+
+        for (size_t chunk_element_count : { 1, 3, 64, 4096 })
+        {
+            TestChunked(strings, chunk_element_count);
+            TestChunked(ints, chunk_element_count);
+            TestChunked(ints, chunk_element_count, awl::io::CompactContext{});
+            TestChunked(structs, chunk_element_count);
+        }
+    }
+}
+
+AWL_TEST(ChunkedReadWriteCorruption)
+{
+    AWL_UNUSED_CONTEXT;
+
+    const std::vector<std::string> sample(100, "abc");
+
+    std::vector<uint8_t> v;
+
+    {
+        awl::io::VectorOutputStream out(v);
+
+        awl::io::WriteChunked(out, sample, awl::io::FakeContext{}, 10);
+    }
+
+    //The first chunk gets an extra byte.
+    const size_t first_chunk_size_pos = 2 * sizeof(size_t);
+
+    size_t first_chunk_size;
+
+    std::memcpy(&first_chunk_size, v.data() + first_chunk_size_pos, sizeof(size_t));
+
+    ++v[first_chunk_size_pos];
+
+    v.insert(v.begin() + first_chunk_size_pos + sizeof(size_t) + first_chunk_size, 0);
+
+    awl::io::VectorInputStream in(v);
+
+    std::vector<std::string> result;
+
+    try
+    {
+        awl::io::ReadChunked(in, result, awl::io::FakeContext{}, 4);
+
+        AWL_FAILM("CorruptionException is not thrown.");
+    }
+    catch (const awl::io::CorruptionException&)
+    {
+    }
+
+    //A wrong chunk size results in the end of the stream, but not in a huge allocation.
+    v.insert(v.begin() + first_chunk_size_pos + 7, 0x7F);
+
+    awl::io::VectorInputStream in1(v);
+
+    try
+    {
+        awl::io::ReadChunked(in1, result, awl::io::FakeContext{}, 4);
+
+        AWL_FAILM("EndOfFileException is not thrown.");
+    }
+    catch (const awl::io::EndOfFileException&)
+    {
+    }
+}
+
+//The stream reuses its buffer, so the borrowed chunks would be overwritten before they are decoded.
+AWL_TEST(ChunkedReadWriteHashStream)
+{
+    AWL_UNUSED_CONTEXT;
+
+    static_assert(!awl::io::pinned_input_stream<awl::io::HashInputStream<awl::crypto::Crc64>>);
+
+    const size_t block_size = 1024;
+
+    std::vector<std::string> sample;
+
+    for (size_t i = 0; i < 10000; ++i)
+    {
+        sample.push_back(std::to_string(i));
+    }
+
+    std::vector<uint8_t> v;
+
+    {
+        awl::io::VectorOutputStream out(v);
+
+        awl::io::HashOutputStream<awl::crypto::Crc64> hout(out, block_size);
+
+        awl::io::WriteChunked(hout, sample, awl::io::FakeContext{}, 100);
+    }
+
+    for (size_t thread_count : { 1, 4 })
+    {
+        awl::io::VectorInputStream in(v);
+
+        awl::io::HashInputStream<awl::crypto::Crc64> hin(in, block_size);
+
+        std::vector<std::string> result;
+
+        awl::io::ReadChunked(hin, result, awl::io::FakeContext{}, thread_count);
+
+        AWL_ASSERT(result == sample);
+    }
+}
+
+AWL_TEST(ChunkedReadWriteCorruptedHeader)
+{
+    AWL_UNUSED_CONTEXT;
+
+    const std::vector<std::string> sample(10, "abc");
+
+    std::vector<uint8_t> v;
+
+    {
+        awl::io::VectorOutputStream out(v);
+
+        awl::io::WriteChunked(out, sample, awl::io::FakeContext{}, 100);
+    }
+
+    //The element count is huge, but the chunk is small, so nothing is allocated.
+    const size_t huge_size = std::numeric_limits<size_t>::max() / 2;
+
+    std::memcpy(v.data(), &huge_size, sizeof(huge_size));
+
+    const size_t huge_chunk_element_count = huge_size;
+
+    for (size_t chunk_element_count : { size_t(100), huge_chunk_element_count })
+    {
+        std::memcpy(v.data() + sizeof(size_t), &chunk_element_count, sizeof(chunk_element_count));
+
+        awl::io::VectorInputStream in(v);
+
+        std::vector<std::string> result;
+
+        try
+        {
+            awl::io::ReadChunked(in, result, awl::io::FakeContext{}, 4);
+
+            AWL_FAILM("IoException is not thrown.");
+        }
+        catch (const awl::io::IoException&)
+        {
+        }
+
+        AWL_ASSERT(result.empty());
+    }
+}
+
+//./AwlTest --filter ChunkedReadWriteScaling.* --output all --element_count 1000000
+AWL_BENCHMARK(ChunkedReadWriteScaling)
+{
+    AWL_ATTRIBUTE(size_t, element_count, 100000);
+    AWL_ATTRIBUTE(size_t, max_thread_count, std::max(std::thread::hardware_concurrency(), 1u));
+
+    const std::vector<vts_data::v1::B> sample(element_count, vts_data::v1::b_expected);
+
+    std::vector<uint8_t> v;
+
+    {
+        awl::io::VectorOutputStream out(v);
+
+        awl::StopWatch w;
+
+        awl::io::WriteChunked(out, sample);
+
+        context.logger.debug(awl::format() << _T("Chunked write, ") << v.size() << _T(" bytes: "));
+
+        helpers::ReportCountAndSpeed(context, w, element_count, v.size());
+    }
+
+    for (size_t thread_count = 1; thread_count <= max_thread_count; thread_count *= 2)
+    {
+        awl::io::VectorInputStream in(v);
+
+        std::vector<vts_data::v1::B> result;
+
+        awl::StopWatch w;
+
+        awl::io::ReadChunked(in, result, awl::io::FakeContext{}, thread_count);
+
+        context.logger.debug(awl::format() << _T("Chunked read with ") << thread_count << _T(" threads: "));
+
+        helpers::ReportCountAndSpeed(context, w, element_count, v.size());
+
+        AWL_ASSERT(result == sample);
+    }
+}
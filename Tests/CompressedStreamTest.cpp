@@ -0,0 +1,360 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Awl/Io/CompressedStream.h"
+#include "Awl/Io/HashStream.h"
+#include "Awl/Io/VectorStream.h"
+#include "Awl/Io/ReadWrite.h"
+#include "Awl/Crypto/Crc64.h"
+
+#include "Awl/Random.h"
+#include "Awl/StopWatch.h"
+#include "Awl/StringFormat.h"
+#include "Awl/Testing/UnitTest.h"
+
+#include "Tests/Helpers/BenchmarkHelpers.h"
+#include "Tests/VtsTestCommon.h"
+
+#include <vector>
+#include <string>
+#include <cstring>
+#include <iterator>
+
+using namespace awl::testing;
+
+namespace
+{
+    enum class DataKind
+    {
+        Random,
+        Zeros,
+        Text,
+        SmallIntegers
+    };
+
+    std::vector<uint8_t> MakeData(DataKind kind, size_t size)
+    {
+        std::vector<uint8_t> v(size);
+
+        switch (kind)
+        {
+            case DataKind::Random:
+            {
+                std::uniform_int_distribution<int> dist(0, 255);
+
+                for (uint8_t& b : v)
+                {
+                    b = static_cast<uint8_t>(dist(awl::random()));
+                }
+
+                break;
+            }
+            case DataKind::Zeros:
+                break;
+            case DataKind::Text:
+            {
+                static const char* words[] = { "key", "value", "price", "volume", "timestamp", " ", ", ", "\n" };
+
+                std::uniform_int_distribution<size_t> dist(0, std::size(words) - 1);
+
+                std::string text;
+
+                while (text.size() < size)
+                {
+                    text += words[dist(awl::random())];
+                }
+
+                std::memcpy(v.data(), text.data(), size);
+
+                break;
+            }
+            case DataKind::SmallIntegers:
+            {
+                std::uniform_int_distribution<int32_t> dist(0, 100);
+
+                for (size_t i = 0; i + sizeof(int32_t) <= size; i += sizeof(int32_t))
+                {
+                    const int32_t val = dist(awl::random());
+
+                    std::memcpy(v.data() + i, &val, sizeof(val));
+                }
+
+                break;
+            }
+        }
+
+        return v;
+    }
+
+    constexpr DataKind allKinds[] = { DataKind::Random, DataKind::Zeros, DataKind::Text, DataKind::SmallIntegers };
+
+    std::vector<uint8_t> Compress(const std::vector<uint8_t>& v)
+    {
+        std::vector<uint8_t> compressed(awl::io::LzCodec::MaxCompressedSize(v.size()));
+
+        compressed.resize(awl::io::LzCodec::Compress(v.data(), v.size(), compressed.data()));
+
+        return compressed;
+    }
+}
+
+AWL_TEST(CompressedStreamCodec)
+{
+    AWL_UNUSED_CONTEXT;
+
+    for (DataKind kind : allKinds)
+    {
+        for (size_t size : { 0, 1, 5, 12, 13, 14, 100, 1000, 65536, 100000, 300000 })
+        {
+            const std::vector<uint8_t> v = MakeData(kind, size);
+
+            const std::vector<uint8_t> compressed = Compress(v);
+
+            AWL_ASSERT(compressed.size() <= awl::io::LzCodec::MaxCompressedSize(size));
+
+            if (kind == DataKind::Zeros && size >= 1000)
+            {
+                //A long match takes a byte per 255 bytes.
+                AWL_ASSERT(compressed.size() < size / 200 + 16);
+            }
+
+            std::vector<uint8_t> actual(size);
+
+            awl::io::LzCodec::Decompress(compressed.data(), compressed.size(), actual.data(), actual.size());
+
+            AWL_ASSERT(actual == v);
+        }
+    }
+}
+
+AWL_TEST(CompressedStreamCodecCorruption)
+{
+    AWL_ATTRIBUTE(size_t, iteration_count, 1000);
+
+    const std::vector<uint8_t> v = MakeData(DataKind::Text, 10000);
+
+    const std::vector<uint8_t> compressed = Compress(v);
+
+    std::uniform_int_distribution<size_t> pos_dist(0, compressed.size() - 1);
+    std::uniform_int_distribution<int> byte_dist(0, 255);
+
+    size_t detected_count = 0;
+
+    for (size_t i = 0; i < iteration_count; ++i)
+    {
+        std::vector<uint8_t> corrupted = compressed;
+
+        if (i % 2 == 0)
+        {
+            corrupted[pos_dist(awl::random())] = static_cast<uint8_t>(byte_dist(awl::random()));
+        }
+        else
+        {
+            corrupted.resize(pos_dist(awl::random()));
+        }
+
+        std::vector<uint8_t> actual(v.size());
+
+        //The decoder never goes out of the buffers, but a change in the literals can't be detected without a hash.
+        try
+        {
+            awl::io::LzCodec::Decompress(corrupted.data(), corrupted.size(), actual.data(), actual.size());
+        }
+        catch (const awl::io::CorruptionException&)
+        {
+            ++detected_count;
+        }
+    }
+
+    context.logger.debug(awl::format() << detected_count << _T(" of ") << iteration_count << _T(" corruptions detected."));
+}
+
+AWL_TEST(CompressedStreamReadWrite)
+{
+    AWL_UNUSED_CONTEXT;
+
+    for (DataKind kind : allKinds)
+    {
+        for (size_t block_size : { 1, 100, 65536 })
+        {
+            const std::vector<uint8_t> sample = MakeData(kind, 200000);
+
+            std::uniform_int_distribution<size_t> dist(0, 1000);
+
+            std::vector<uint8_t> v;
+
+            {
+                awl::io::VectorOutputStream out(v);
+
+                awl::io::CompressedOutputStream compressed_out(out, block_size);
+
+                for (size_t pos = 0; pos != sample.size();)
+                {
+                    const size_t count = std::min(dist(awl::random()), sample.size() - pos);
+
+                    compressed_out.Write(sample.data() + pos, count);
+
+                    pos += count;
+
+                    //The blocks are independent.
+                    if (count % 7 == 0)
+                    {
+                        compressed_out.Flush();
+                    }
+                }
+            }
+
+            awl::io::VectorInputStream in(v);
+
+            awl::io::CompressedInputStream compressed_in(in, block_size);
+
+            std::vector<uint8_t> actual;
+
+            while (!compressed_in.End())
+            {
+                const size_t count = dist(awl::random());
+
+                if (const uint8_t* p = compressed_in.Borrow(count))
+                {
+                    actual.insert(actual.end(), p, p + count);
+                }
+                else
+                {
+                    std::vector<uint8_t> buffer(count);
+
+                    buffer.resize(compressed_in.Read(buffer.data(), count));
+
+                    actual.insert(actual.end(), buffer.begin(), buffer.end());
+                }
+            }
+
+            AWL_ASSERT(actual == sample);
+        }
+    }
+}
+
+AWL_TEST(CompressedStreamOverHashStream)
+{
+    AWL_UNUSED_CONTEXT;
+
+    using Hash = awl::crypto::Crc64;
+
+    const std::vector<uint8_t> sample = MakeData(DataKind::SmallIntegers, 300000);
+
+    std::vector<uint8_t> v;
+
+    {
+        awl::io::VectorOutputStream out(v);
+
+        awl::io::HashOutputStream<Hash> hout(out);
+
+        awl::io::CompressedOutputStream compressed_out(hout);
+
+        awl::io::Write(compressed_out, sample);
+    }
+
+    AWL_ASSERT(v.size() < sample.size());
+
+    auto read = [](const std::vector<uint8_t>& data)
+    {
+        awl::io::VectorInputStream in(data);
+
+        awl::io::HashInputStream<Hash> hin(in);
+
+        awl::io::CompressedInputStream compressed_in(hin);
+
+        std::vector<uint8_t> actual;
+
+        awl::io::Read(compressed_in, actual);
+
+        AWL_ASSERT(compressed_in.End());
+
+        return actual;
+    };
+
+    AWL_ASSERT(read(v) == sample);
+
+    //A corruption is detected by the hash before the block is decompressed.
+    v[v.size() / 2] ^= 1;
+
+    try
+    {
+        read(v);
+
+        AWL_FAILM("CorruptionException is not thrown.");
+    }
+    catch (const awl::io::CorruptionException&)
+    {
+    }
+}
+
+//./AwlTest --filter CompressedStreamVts.* --output all --element_count 1000000
+AWL_BENCHMARK(CompressedStreamVts)
+{
+    using namespace awl::testing::vts_common;
+
+    AWL_ATTRIBUTE(size_t, element_count, 100000);
+
+    std::vector<uint8_t> raw;
+
+    {
+        awl::io::VectorOutputStream out(raw);
+
+        WriteDataV1<OldWriter<awl::io::SequentialOutputStream>>(out, element_count, true);
+    }
+
+    std::vector<uint8_t> compressed;
+
+    {
+        awl::io::VectorOutputStream out(compressed);
+
+        awl::StopWatch w;
+
+        {
+            awl::io::CompressedOutputStream compressed_out(out);
+
+            compressed_out.Write(raw.data(), raw.size());
+        }
+
+        context.logger.debug(awl::format() << _T("Compressed ") << raw.size() << _T(" -> ") << compressed.size() << _T(" bytes, ratio ") <<
+            static_cast<double>(raw.size()) / static_cast<double>(compressed.size()) << _T(": "));
+
+        helpers::ReportSpeed(context, w, raw.size());
+    }
+
+    {
+        std::vector<uint8_t> actual(raw.size());
+
+        awl::io::VectorInputStream in(compressed);
+
+        awl::StopWatch w;
+
+        {
+            awl::io::CompressedInputStream compressed_in(in);
+
+            AWL_ASSERT(compressed_in.Read(actual.data(), actual.size()) == actual.size());
+
+            AWL_ASSERT(compressed_in.End());
+        }
+
+        context.logger.debug(_T("Decompressed: "));
+
+        helpers::ReportSpeed(context, w, raw.size());
+
+        AWL_ASSERT(actual == raw);
+    }
+
+    {
+        awl::io::VectorInputStream in(compressed);
+
+        awl::io::CompressedInputStream compressed_in(in);
+
+        const auto d = ReadDataV2<NewReader<awl::io::SequentialInputStream>>(compressed_in, element_count);
+
+        context.logger.debug(_T("Version 2 has been read from the compressed stream: "));
+
+        helpers::ReportCountAndSpeed(context, d, element_count, raw.size());
+    }
+}
@@ -0,0 +1,318 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Awl/DynamicBitMap.h"
+#include "Awl/Random.h"
+#include "Awl/StopWatch.h"
+#include "Awl/StringFormat.h"
+
+#include "Awl/Testing/UnitTest.h"
+
+#include "Tests/Helpers/RwTest.h"
+#include "Helpers/BenchmarkHelpers.h"
+
+#include <vector>
+#include <limits>
+#include <cstring>
+
+using namespace awl::testing;
+
+namespace
+{
+    std::vector<bool> MakeRandomBits(size_t size, int percent)
+    {
+        std::uniform_int_distribution<int> dist(0, 99);
+
+        std::vector<bool> v(size);
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            v[i] = dist(awl::random()) < percent;
+        }
+
+        return v;
+    }
+
+    awl::dynamic_bitmap MakeBitmap(const std::vector<bool>& v)
+    {
+        awl::dynamic_bitmap bm(v.size());
+
+        for (size_t i = 0; i < v.size(); ++i)
+        {
+            bm.set(i, v[i]);
+        }
+
+        return bm;
+    }
+
+    void AssertEqual(const std::vector<bool>& expected, const awl::dynamic_bitmap& actual)
+    {
+        AWL_ASSERT_EQUAL(expected.size(), actual.size());
+
+        std::vector<size_t> positions;
+
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            AWL_ASSERT_EQUAL(expected[i], actual[i]);
+
+            if (expected[i])
+            {
+                positions.push_back(i);
+            }
+        }
+
+        AWL_ASSERT_EQUAL(positions.size(), actual.count());
+        AWL_ASSERT(std::ranges::equal(positions, actual.set_bits()));
+        AWL_ASSERT_EQUAL(positions.empty() ? awl::dynamic_bitmap::npos : positions.front(), actual.find_first());
+    }
+}
+
+AWL_TEST(DynamicBitMapBulk)
+{
+    AWL_UNUSED_CONTEXT;
+
+    AWL_ATTRIBUTE(size_t, iteration_count, 20);
+
+    for (size_t iteration = 0; iteration < iteration_count; ++iteration)
+    {
+        //Check the sizes that are not multiple of the word size.
+        const size_t size = iteration * 37 + iteration % 3;
+
+        const std::vector<bool> a = MakeRandomBits(size, 50);
+        const std::vector<bool> b = MakeRandomBits(size, 10);
+
+        const awl::dynamic_bitmap bm_a = MakeBitmap(a);
+        const awl::dynamic_bitmap bm_b = MakeBitmap(b);
+
+        AssertEqual(a, bm_a);
+        AssertEqual(b, bm_b);
+
+        std::vector<bool> v_and(size), v_or(size), v_xor(size), v_and_not(size), v_not(size);
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            v_and[i] = a[i] && b[i];
+            v_or[i] = a[i] || b[i];
+            v_xor[i] = a[i] != b[i];
+            v_and_not[i] = a[i] && !b[i];
+            v_not[i] = !a[i];
+        }
+
+        AssertEqual(v_and, bm_a & bm_b);
+        AssertEqual(v_or, bm_a | bm_b);
+        AssertEqual(v_xor, bm_a ^ bm_b);
+        AssertEqual(v_and_not, awl::dynamic_bitmap(bm_a).and_not(bm_b));
+        AssertEqual(v_not, ~bm_a);
+
+        AWL_ASSERT_EQUAL((bm_a & bm_b).count(), bm_a.count_and(bm_b));
+
+        AWL_ASSERT(awl::dynamic_bitmap(size, true).all());
+        AWL_ASSERT(awl::dynamic_bitmap(size, false).none());
+        AWL_ASSERT_EQUAL(size, awl::dynamic_bitmap(size).set().count());
+    }
+}
+
+AWL_TEST(DynamicBitMapResize)
+{
+    AWL_UNUSED_CONTEXT;
+
+    awl::dynamic_bitmap bm(10);
+
+    bm.set(3);
+    bm.resize(100, true);
+
+    AWL_ASSERT_EQUAL(static_cast<size_t>(91), bm.count());
+    AWL_ASSERT_FALSE(bm[9]);
+    AWL_ASSERT(bm[10]);
+
+    bm.resize(5);
+
+    AWL_ASSERT_EQUAL(static_cast<size_t>(1), bm.count());
+
+    bm.resize(200);
+
+    AWL_ASSERT_EQUAL(static_cast<size_t>(1), bm.count());
+    AWL_ASSERT_EQUAL(static_cast<size_t>(3), bm.find_first());
+    AWL_ASSERT_EQUAL(awl::dynamic_bitmap::npos, bm.find_next(4));
+}
+
+AWL_TEST(DynamicBitMapRankSelect)
+{
+    AWL_UNUSED_CONTEXT;
+
+    AWL_ATTRIBUTE(size_t, size, 5000);
+
+    for (int percent : { 0, 1, 50, 100 })
+    {
+        const std::vector<bool> v = MakeRandomBits(size, percent);
+
+        awl::dynamic_bitmap bm = MakeBitmap(v);
+
+        for (bool indexed : { false, true })
+        {
+            if (indexed)
+            {
+                bm.build_rank_index();
+            }
+
+            AWL_ASSERT_EQUAL(indexed, bm.has_rank_index());
+
+            size_t rank = 0;
+
+            for (size_t i = 0; i < size; ++i)
+            {
+                AWL_ASSERT_EQUAL(rank, bm.rank(i));
+
+                if (v[i])
+                {
+                    AWL_ASSERT_EQUAL(i, bm.select(rank));
+
+                    ++rank;
+                }
+            }
+
+            AWL_ASSERT_EQUAL(rank, bm.rank(size));
+            AWL_ASSERT_EQUAL(awl::dynamic_bitmap::npos, bm.select(rank));
+        }
+
+        //A modification invalidates the index.
+        bm.flip(0);
+
+        AWL_ASSERT_FALSE(bm.has_rank_index());
+    }
+}
+
+AWL_TEST(DynamicBitMapReadWrite)
+{
+    //The last size takes more than one read step.
+    for (size_t size : { 0, 1, 63, 64, 65, 1000, 64 * 64 * 1024 + 1 })
+    {
+        helpers::TestReadWrite(context, MakeBitmap(MakeRandomBits(size, 50)));
+    }
+}
+
+AWL_TEST(DynamicBitMapReadCorrupted)
+{
+    AWL_UNUSED_CONTEXT;
+
+    std::vector<uint8_t> v;
+
+    {
+        VectorOutputStream out(v);
+
+        Write(out, MakeBitmap(MakeRandomBits(1000, 50)));
+    }
+
+    //A huge size that is not followed by the words.
+    const size_t size = std::numeric_limits<size_t>::max() - 1;
+
+    std::memcpy(v.data(), &size, sizeof(size));
+
+    VectorInputStream in(v);
+
+    try
+    {
+        awl::dynamic_bitmap bm;
+
+        Read(in, bm);
+
+        AWL_FAILM("EndOfFileException is not thrown.");
+    }
+    catch (const EndOfFileException&)
+    {
+    }
+}
+
+AWL_BENCHMARK(DynamicBitMapVsVectorBool)
+{
+    AWL_ATTRIBUTE(size_t, size, 10000000);
+    AWL_ATTRIBUTE(size_t, iteration_count, 10);
+
+    const std::vector<bool> a = MakeRandomBits(size, 50);
+    const std::vector<bool> b = MakeRandomBits(size, 10);
+
+    size_t expected = 0;
+
+    {
+        awl::StopWatch w;
+
+        std::vector<bool> result;
+
+        for (size_t i = 0; i < iteration_count; ++i)
+        {
+            result = a;
+
+            for (size_t j = 0; j < size; ++j)
+            {
+                result[j] = result[j] && !b[j];
+            }
+
+            expected = static_cast<size_t>(std::ranges::count(result, true));
+        }
+
+        context.logger.debug(_T("std::vector<bool> AND NOT + count: "));
+        helpers::ReportCount(context, w, size * iteration_count);
+    }
+
+    const awl::dynamic_bitmap bm_a = MakeBitmap(a);
+    const awl::dynamic_bitmap bm_b = MakeBitmap(b);
+
+    {
+        awl::StopWatch w;
+
+        awl::dynamic_bitmap result;
+
+        for (size_t i = 0; i < iteration_count; ++i)
+        {
+            result = bm_a;
+
+            result.and_not(bm_b);
+
+            AWL_ASSERT_EQUAL(expected, result.count());
+        }
+
+        context.logger.debug(_T("dynamic_bitmap AND NOT + count: "));
+        helpers::ReportCount(context, w, size * iteration_count);
+    }
+
+    {
+        awl::StopWatch w;
+
+        size_t sum = 0;
+
+        for (size_t i = 0; i < iteration_count; ++i)
+        {
+            for (size_t pos : bm_b.set_bits())
+            {
+                sum += pos;
+            }
+        }
+
+        context.logger.debug(awl::format() << _T("dynamic_bitmap set bit iteration (") << sum << _T("): "));
+        helpers::ReportCount(context, w, size * iteration_count);
+    }
+
+    {
+        awl::dynamic_bitmap bm = bm_a;
+
+        bm.build_rank_index();
+
+        const size_t count = bm.count();
+
+        std::uniform_int_distribution<size_t> dist(0, count - 1);
+
+        awl::StopWatch w;
+
+        size_t sum = 0;
+
+        for (size_t i = 0; i < iteration_count * 100000; ++i)
+        {
+            sum += bm.select(dist(awl::random()));
+        }
+
+        context.logger.debug(awl::format() << _T("dynamic_bitmap select (") << sum << _T("): "));
+        helpers::ReportCount(context, w, iteration_count * 100000);
+    }
+}
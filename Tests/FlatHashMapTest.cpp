@@ -0,0 +1,270 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Awl/FlatHashMap.h"
+#include "Awl/KeyCompare.h"
+#include "Awl/Random.h"
+#include "Awl/Tuplizable.h"
+
+#include "Awl/Testing/UnitTest.h"
+
+#include "Tests/Helpers/RwTest.h"
+
+#include <string>
+#include <unordered_map>
+#include <ranges>
+
+using namespace awl::testing;
+
+namespace
+{
+    using Map = awl::flat_hash_map<int, std::string>;
+
+    static_assert(std::ranges::forward_range<Map>);
+    static_assert(std::ranges::forward_range<const Map>);
+
+    void AssertEqual(const std::unordered_map<int, std::string>& expected, const Map& actual)
+    {
+        AWL_ASSERT_EQUAL(expected.size(), actual.size());
+        AWL_ASSERT_EQUAL(expected.size(), static_cast<size_t>(std::ranges::distance(actual)));
+
+        for (const auto& [key, value] : expected)
+        {
+            auto i = actual.find(key);
+
+            AWL_ASSERT(i != actual.end());
+            AWL_ASSERT(i->second == value);
+        }
+    }
+
+    struct Point
+    {
+        int x;
+        int y;
+
+        AWL_TUPLIZABLE(x, y)
+    };
+
+    AWL_MEMBERWISE_EQUATABLE(Point)
+
+    struct Employee
+    {
+        int id;
+        std::string name;
+
+        AWL_TUPLIZABLE(id, name)
+    };
+
+    AWL_MEMBERWISE_EQUATABLE(Employee)
+}
+
+AWL_TEST(FlatHashMapInsertErase)
+{
+    AWL_UNUSED_CONTEXT;
+
+    AWL_ATTRIBUTE(size_t, iteration_count, 100000);
+    AWL_ATTRIBUTE(int, range, 1000);
+
+    std::unordered_map<int, std::string> expected;
+    Map actual;
+
+    std::uniform_int_distribution<int> key_dist(0, range);
+    std::uniform_int_distribution<int> op_dist(0, 2);
+
+    for (size_t i = 0; i < iteration_count; ++i)
+    {
+        const int key = key_dist(awl::random());
+
+        switch (op_dist(awl::random()))
+        {
+            case 0:
+            {
+                const std::string value = std::to_string(i);
+
+                const bool inserted = expected.insert({ key, value }).second;
+
+                auto [actual_i, actual_inserted] = actual.insert({ key, value });
+
+                AWL_ASSERT_EQUAL(inserted, actual_inserted);
+                AWL_ASSERT(actual_i->first == key);
+                break;
+            }
+            case 1:
+                AWL_ASSERT_EQUAL(expected.erase(key), actual.erase(key));
+                break;
+            case 2:
+            {
+                const std::string value(1, 'x');
+
+                expected[key] = value;
+                actual[key] = value;
+                break;
+            }
+        }
+
+        //Erasing by iterator while iterating.
+        if (i % 10000 == 0)
+        {
+            for (auto j = actual.begin(); j != actual.end();)
+            {
+                if (j->first % 3 == 0)
+                {
+                    expected.erase(j->first);
+                    j = actual.erase(j);
+                }
+                else
+                {
+                    ++j;
+                }
+            }
+        }
+    }
+
+    AssertEqual(expected, actual);
+
+    Map copy = actual;
+
+    AWL_ASSERT(copy == actual);
+
+    Map moved = std::move(copy);
+
+    AWL_ASSERT(copy.empty());
+    AWL_ASSERT(moved == actual);
+
+    actual.clear();
+    expected.clear();
+
+    AssertEqual(expected, actual);
+    AWL_ASSERT(actual.find(1) == actual.end());
+}
+
+//The table never has more elements than its maximum load, so the probing for an absent key stops at an empty slot.
+AWL_TEST(FlatHashMapMaxLoad)
+{
+    AWL_UNUSED_CONTEXT;
+
+    awl::flat_hash_set<int> set;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        set.insert(i);
+
+        const size_t capacity = set.bucket_count();
+
+        AWL_ASSERT(set.size() <= capacity - capacity / 8);
+
+        for (int key = -10; key < 0; ++key)
+        {
+            AWL_ASSERT(set.find(key) == set.end());
+        }
+
+        AWL_ASSERT(set.find(i) != set.end());
+    }
+
+    //The inserts up to exactly the load limit of a small table.
+    {
+        awl::flat_hash_set<int> small_set;
+
+        small_set.insert(0);
+
+        const size_t capacity = small_set.bucket_count();
+
+        const int max_load = static_cast<int>(capacity - capacity / 8);
+
+        for (int i = 1; i < max_load; ++i)
+        {
+            small_set.insert(i);
+        }
+
+        AWL_ASSERT_EQUAL(capacity, small_set.bucket_count());
+        AWL_ASSERT_EQUAL(static_cast<size_t>(max_load), small_set.size());
+
+        for (int key = max_load; key < max_load + 100; ++key)
+        {
+            AWL_ASSERT(small_set.find(key) == small_set.end());
+        }
+
+        //The next insert grows the table.
+        small_set.insert(max_load);
+
+        AWL_ASSERT(small_set.bucket_count() > capacity);
+    }
+}
+
+AWL_TEST(FlatHashMapTryEmplace)
+{
+    AWL_UNUSED_CONTEXT;
+
+    Map m{ { 1, "a" }, { 2, "b" } };
+
+    AWL_ASSERT_FALSE(m.try_emplace(1, "c").second);
+    AWL_ASSERT(m.at(1) == "a");
+
+    AWL_ASSERT(m.try_emplace(3, 2, 'c').second);
+    AWL_ASSERT(m.at(3) == "cc");
+
+    AWL_ASSERT_FALSE(m.insert_or_assign(3, std::string("d")).second);
+    AWL_ASSERT(m.at(3) == "d");
+
+    m.reserve(1000);
+
+    AWL_ASSERT(m.bucket_count() >= 1000);
+    AWL_ASSERT(m.at(2) == "b");
+    AWL_ASSERT_EQUAL(static_cast<size_t>(3), m.size());
+}
+
+AWL_TEST(FlatHashSetTuplizable)
+{
+    AWL_UNUSED_CONTEXT;
+
+    awl::flat_hash_set<Point> set;
+
+    for (int x = 0; x < 100; ++x)
+    {
+        for (int y = 0; y < 100; ++y)
+        {
+            AWL_ASSERT(set.insert(Point{ x, y }).second);
+        }
+    }
+
+    AWL_ASSERT_EQUAL(static_cast<size_t>(10000), set.size());
+    AWL_ASSERT(set.contains(Point{ 5, 7 }));
+    AWL_ASSERT_FALSE(set.contains(Point{ 5, 100 }));
+    AWL_ASSERT_FALSE(set.insert(Point{ 99, 99 }).second);
+}
+
+AWL_TEST(FlatHashSetHeterogeneous)
+{
+    AWL_UNUSED_CONTEXT;
+
+    using Set = awl::flat_hash_set<Employee, awl::member_hash<&Employee::id>, awl::member_equal<&Employee::id>>;
+
+    Set set{ { 1, "Alice" }, { 2, "Bob" } };
+
+    //The lookup by the key without constructing an element.
+    AWL_ASSERT(set.find(1)->name == "Alice");
+    AWL_ASSERT(set.contains(2));
+    AWL_ASSERT_FALSE(set.contains(3));
+
+    AWL_ASSERT_FALSE(set.insert(Employee{ 2, "Robert" }).second);
+    AWL_ASSERT(set.find(2)->name == "Bob");
+
+    AWL_ASSERT_EQUAL(static_cast<size_t>(1), set.erase(1));
+    AWL_ASSERT_EQUAL(static_cast<size_t>(1), set.size());
+}
+
+AWL_TEST(FlatHashMapReadWrite)
+{
+    Map m;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        m.emplace(i, std::to_string(i));
+    }
+
+    helpers::TestReadWrite(context, m);
+
+    helpers::TestReadWrite(context, awl::flat_hash_set<std::string>{ "a", "b", "c" });
+}
@@ -15,6 +15,7 @@
 #include "Awl/Random.h"
 #include "Awl/KeyCompare.h"
 #include "Awl/StringFormat.h"
+#include "Awl/FlatHashMap.h"
 
 #include "Helpers/BenchmarkHelpers.h"
 
@@ -114,6 +115,7 @@ AWL_BENCHMARK(FlatMapInsert)
 
     Insert<std::map<size_t, size_t>>(context, _T("map"));
     Insert<std::unordered_map<size_t, size_t>>(context, _T("unordered_map"));
+    Insert<awl::flat_hash_map<size_t, size_t>>(context, _T("flat_hash_map"));
 
     if (flat)
     {
@@ -122,6 +124,63 @@ AWL_BENCHMARK(FlatMapInsert)
     }
 }
 
+namespace
+{
+    template <class T>
+    void Find(const TestContext& context, const awl::Char* type_name, const std::vector<size_t>& keys, const std::vector<size_t>& missing_keys)
+    {
+        AWL_ATTRIBUTE(size_t, find_count, 10000000);
+
+        T container;
+
+        for (size_t key : keys)
+        {
+            container.insert(std::make_pair(key, key));
+        }
+
+        std::uniform_int_distribution<size_t> index_dist(0, keys.size() + missing_keys.size() - 1);
+
+        size_t found_count = 0;
+
+        awl::StopWatch w;
+
+        for (size_t i = 0; i < find_count; ++i)
+        {
+            //A half of the keys are missing.
+            const size_t index = index_dist(awl::random());
+
+            const size_t key = index < keys.size() ? keys[index] : missing_keys[index - keys.size()];
+
+            if (container.find(key) != container.end())
+            {
+                ++found_count;
+            }
+        }
+
+        helpers::ReportCount(context, w, find_count);
+
+        context.logger.debug(awl::format() << _T("\t") << type_name << _T(", found: ") << found_count);
+    }
+}
+
+AWL_BENCHMARK(FlatMapFind)
+{
+    AWL_ATTRIBUTE(size_t, element_count, 1000000);
+
+    std::vector<size_t> keys(element_count);
+    std::vector<size_t> missing_keys(element_count);
+
+    //The keys are odd, the missing keys are even, so they are spread over the same range.
+    for (size_t i = 0; i < element_count; ++i)
+    {
+        keys[i] = awl::random()() * 2 + 1;
+        missing_keys[i] = awl::random()() * 2;
+    }
+
+    Find<std::unordered_map<size_t, size_t>>(context, _T("unordered_map"), keys, missing_keys);
+    Find<awl::flat_hash_map<size_t, size_t>>(context, _T("flat_hash_map"), keys, missing_keys);
+}
+
 AWL_BENCHMARK(MemoryRead)
 {
     AWL_ATTRIBUTE(size_t, element_count, 1024*1024);
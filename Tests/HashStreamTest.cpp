@@ -11,8 +11,11 @@
 #include <memory>
 #include <functional>
 #include <fstream>
+#include <filesystem>
 
 #include "Awl/Io/HashStream.h"
+#include "Awl/Io/PipelinedHashStream.h"
+#include "Awl/Io/ParallelHashStream.h"
 #include "Awl/Io/BufferedStream.h"
 #include "Awl/Io/VectorStream.h"
 #include "Awl/Io/StdStream.h"
@@ -20,6 +23,11 @@
 #include "Awl/Io/IoException.h"
 
 #include "Awl/Crypto/Crc64.h"
+#include "Awl/Crypto/ParallelCrc64.h"
+
+#ifdef AWL_OPENSSL_HASH
+#include "Awl/Crypto/OpenSslHash.h"
+#endif
 
 #include "Awl/String.h"
 #include "Awl/StringFormat.h"
@@ -294,3 +302,443 @@ AWL_TEST(IoHashStreamOnFileFake)
 {
     TestOnFile(context, awl::crypto::FakeHash(), MakeVector(context));
 }
+
+AWL_TEST(IoHashStreamBorrow)
+{
+    AWL_UNUSED_CONTEXT;
+
+    static_assert(lending_input_stream<VectorInputStream>);
+    static_assert(lending_input_stream<HashInputStream<awl::crypto::Crc64>>);
+    //The readers do not call the default Borrow and Peek through the base class.
+    static_assert(!lending_input_stream<SequentialInputStream>);
+
+    const std::vector<uint8_t> bytes = { 1, 2, 3, 4, 5 };
+
+    {
+        VectorInputStream in(bytes);
+
+        AWL_ASSERT(in.Peek(6) == nullptr);
+        AWL_ASSERT(in.Peek(2) == bytes.data());
+        AWL_ASSERT(in.Borrow(2) == bytes.data());
+        AWL_ASSERT(in.Borrow(3) == bytes.data() + 2);
+        AWL_ASSERT(in.End());
+        AWL_ASSERT(in.Borrow(1) == nullptr);
+    }
+
+    //The values and the strings cross the block boundaries,
+    //so the readers alternate between borrowing and copying.
+    const size_t block_size = 16;
+
+    std::vector<uint8_t> v;
+
+    {
+        VectorOutputStream out(v);
+
+        HashOutputStream<awl::crypto::Crc64> hout(out, block_size);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            Write(hout, i);
+            Write(hout, std::string(static_cast<size_t>(i % 10), 'a'));
+            Write(hout, std::vector<uint16_t>(static_cast<size_t>(i % 7), static_cast<uint16_t>(i)));
+        }
+    }
+
+    VectorInputStream in(v);
+
+    HashInputStream<awl::crypto::Crc64> hin(in, block_size);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        int val;
+        Read(hin, val);
+        AWL_ASSERT_EQUAL(i, val);
+
+        std::string s;
+        Read(hin, s);
+        AWL_ASSERT(s == std::string(static_cast<size_t>(i % 10), 'a'));
+
+        std::vector<uint16_t> numbers;
+        Read(hin, numbers);
+        AWL_ASSERT(numbers == std::vector<uint16_t>(static_cast<size_t>(i % 7), static_cast<uint16_t>(i)));
+    }
+
+    AWL_ASSERT(hin.End());
+    AWL_ASSERT(hin.Peek(1) == nullptr);
+}
+
+AWL_TEST(IoHashStreamParallelCrc64)
+{
+    AWL_UNUSED_CONTEXT;
+
+    const size_t block_size = 100000;
+
+    std::vector<uint8_t> sample(1000000);
+
+    std::uniform_int_distribution<int> dist(0, 255);
+
+    for (uint8_t& b : sample)
+    {
+        b = static_cast<uint8_t>(dist(awl::random()));
+    }
+
+    //Large blocks are hashed by several threads, but the format is the same.
+    const awl::crypto::ParallelCrc64 hash(127, 4, 10000);
+
+    std::vector<uint8_t> v;
+
+    {
+        VectorOutputStream out(v);
+
+        HashOutputStream<awl::crypto::ParallelCrc64> hout(out, block_size, hash);
+
+        Write(hout, sample);
+    }
+
+    VectorInputStream in(v);
+
+    HashInputStream<awl::crypto::Crc64> hin(in, block_size);
+
+    std::vector<uint8_t> actual;
+
+    Read(hin, actual);
+
+    AWL_ASSERT(actual == sample);
+    AWL_ASSERT(hin.End());
+}
+
+AWL_TEST(IoPipelinedHashStream)
+{
+    AWL_UNUSED_CONTEXT;
+
+    const size_t block_size = 64;
+
+    std::vector<uint8_t> sample(10000);
+
+    std::uniform_int_distribution<int> dist(0, 255);
+
+    for (uint8_t& b : sample)
+    {
+        b = static_cast<uint8_t>(dist(awl::random()));
+    }
+
+    std::vector<uint8_t> expected;
+
+    {
+        VectorOutputStream out(expected);
+
+        HashOutputStream<awl::crypto::Crc64> hout(out, block_size);
+
+        Write(hout, sample);
+    }
+
+    //The format is the same.
+    for (size_t depth : { 1, 2, 4 })
+    {
+        std::vector<uint8_t> v;
+
+        {
+            VectorOutputStream out(v);
+
+            PipelinedHashOutputStream<awl::crypto::Crc64> hout(out, block_size, {}, depth);
+
+            Write(hout, sample);
+        }
+
+        AWL_ASSERT(v == expected);
+
+        VectorInputStream in(v);
+
+        PipelinedHashInputStream<awl::crypto::Crc64> hin(in, block_size, {}, depth);
+
+        std::vector<uint8_t> actual;
+
+        Read(hin, actual);
+
+        AWL_ASSERT(actual == sample);
+        AWL_ASSERT(hin.End());
+    }
+
+    //A corrupted block is reported when the reader reaches it.
+    expected[expected.size() / 2] ^= 1;
+
+    VectorInputStream in(expected);
+
+    PipelinedHashInputStream<awl::crypto::Crc64> hin(in, block_size);
+
+    try
+    {
+        std::vector<uint8_t> actual;
+
+        Read(hin, actual);
+
+        AWL_FAILM("Corrupted stream.");
+    }
+    catch (const CorruptionException&)
+    {
+    }
+}
+
+namespace
+{
+    class FailingOutputStream : public SequentialOutputStream
+    {
+    public:
+
+        FailingOutputStream(size_t capacity) : m_capacity(capacity)
+        {
+        }
+
+        void Write(const uint8_t* buffer, size_t count) override
+        {
+            static_cast<void>(buffer);
+
+            if (count > m_capacity)
+            {
+                throw WriteFailException();
+            }
+
+            m_capacity -= count;
+        }
+
+    private:
+
+        size_t m_capacity;
+    };
+}
+
+AWL_TEST(IoPipelinedHashStreamWriteFail)
+{
+    AWL_UNUSED_CONTEXT;
+
+    const size_t block_size = 64;
+
+    const std::vector<uint8_t> sample(1000, 5);
+
+    //Only the last incomplete block fails, so the error is detected after all the data is written.
+    const size_t capacity = sample.size() / (block_size - awl::crypto::Crc64::size()) * block_size;
+
+    //Close() reports the error of a block written in the background.
+    {
+        FailingOutputStream out(capacity);
+
+        PipelinedHashOutputStream<awl::crypto::Crc64, FailingOutputStream> hout(out, block_size);
+
+        try
+        {
+            hout.Write(sample.data(), sample.size());
+
+            hout.Close();
+
+            AWL_FAILM("WriteFailException is not thrown.");
+        }
+        catch (const WriteFailException&)
+        {
+        }
+    }
+
+    //The destructor swallows it.
+    {
+        FailingOutputStream out(capacity);
+
+        PipelinedHashOutputStream<awl::crypto::Crc64, FailingOutputStream> hout(out, block_size);
+
+        hout.Write(sample.data(), sample.size());
+    }
+}
+
+namespace
+{
+    template <class Hash, template <class, class> class OutputStream, template <class, class> class InputStream>
+    void TestHashOverlap(const TestContext& context, const awl::String& name)
+    {
+        AWL_ATTRIBUTE(size_t, block_size, 1024 * 64);
+        AWL_ATTRIBUTE(size_t, sample_size, 1024 * 1024);
+        AWL_ATTRIBUTE(size_t, sample_count, 100);
+
+        const std::vector<uint8_t> sample(sample_size, 5);
+
+        const size_t total_size = sample_size * sample_count;
+
+        static const awl::Char file_name[] = _T("hash-overlap-test.dat");
+
+        {
+            std::ofstream fout(file_name, std::ios::out | std::ostream::binary);
+
+            StdOutputStream out(fout);
+
+            awl::StopWatch w;
+
+            {
+                OutputStream<Hash, SequentialOutputStream> hout(out, block_size);
+
+                for (size_t i = 0; i < sample_count; ++i)
+                {
+                    hout.Write(sample.data(), sample.size());
+                }
+            }
+
+            context.logger.debug(awl::format() << name << _T(" write: "));
+
+            helpers::ReportSpeed(context, w, total_size);
+        }
+
+        {
+            std::ifstream fin(file_name, std::ios::in | std::istream::binary);
+
+            StdInputStream in(fin);
+
+            std::vector<uint8_t> result(sample_size);
+
+            awl::StopWatch w;
+
+            InputStream<Hash, SequentialInputStream> hin(in, block_size);
+
+            for (size_t i = 0; i < sample_count; ++i)
+            {
+                ReadRaw(hin, result.data(), result.size());
+            }
+
+            AWL_ASSERT(hin.End());
+
+            context.logger.debug(awl::format() << name << _T(" read: "));
+
+            helpers::ReportSpeed(context, w, total_size);
+        }
+
+        std::filesystem::remove(file_name);
+    }
+
+    template <class Hash>
+    void TestHashOverlap(const TestContext& context, const awl::Char* name)
+    {
+        TestHashOverlap<Hash, HashOutputStream, HashInputStream>(context, awl::format() << name << _T(", synchronous"));
+        TestHashOverlap<Hash, PipelinedHashOutputStream, PipelinedHashInputStream>(context, awl::format() << name << _T(", pipelined"));
+    }
+}
+
+//The gain is the overlap of hashing with the file I/O, so it requires at least two cores.
+AWL_BENCHMARK(IoPipelinedHashStreamOverlap)
+{
+    TestHashOverlap<awl::crypto::Crc64>(context, _T("Crc64"));
+
+#ifdef AWL_OPENSSL_HASH
+    TestHashOverlap<awl::crypto::Sha256>(context, _T("Sha256"));
+#endif
+}
+
+AWL_TEST(IoParallelHashStream)
+{
+    AWL_UNUSED_CONTEXT;
+
+    const size_t block_size = 64;
+
+    for (size_t sample_size : { 0, 1, 55, 56, 57, 10000 })
+    {
+        const auto range = awl::make_count(static_cast<int>(sample_size));
+
+        const std::vector<int> sample(range.begin(), range.end());
+
+        std::vector<uint8_t> v;
+
+        {
+            VectorOutputStream out(v);
+
+            HashOutputStream<awl::crypto::Crc64> hout(out, block_size);
+
+            Write(hout, sample);
+        }
+
+        for (size_t thread_count : { 1, 3 })
+        {
+            {
+                ParallelHashInputStream<awl::crypto::Crc64> hin(std::span<const uint8_t>(v), block_size, {}, thread_count);
+
+                std::vector<int> actual;
+
+                Read(hin, actual);
+
+                AWL_ASSERT(actual == sample);
+                AWL_ASSERT(hin.End());
+            }
+
+            for (size_t batch_block_count : { 1, 2, 100 })
+            {
+                VectorInputStream in(v);
+
+                ParallelHashInputStream<awl::crypto::Crc64> hin(in, block_size, {}, thread_count, batch_block_count);
+
+                std::vector<int> actual;
+
+                Read(hin, actual);
+
+                AWL_ASSERT(actual == sample);
+                AWL_ASSERT(hin.End());
+            }
+        }
+
+        if (!v.empty())
+        {
+            v[v.size() - 1] ^= 1;
+
+            try
+            {
+                ParallelHashInputStream<awl::crypto::Crc64> hin(std::span<const uint8_t>(v), block_size);
+
+                AWL_FAILM("Corrupted stream.");
+            }
+            catch (const CorruptionException&)
+            {
+            }
+        }
+    }
+}
+
+//./AwlTest --filter IoParallelHashVerify.* --output all --block_count 10000
+AWL_BENCHMARK(IoParallelHashVerify)
+{
+    AWL_ATTRIBUTE(size_t, block_size, 1024 * 64);
+    AWL_ATTRIBUTE(size_t, block_count, 1000);
+
+    const std::vector<uint8_t> sample(block_size * block_count, 7);
+
+    std::vector<uint8_t> v;
+
+    {
+        VectorOutputStream out(v);
+
+        HashOutputStream<awl::crypto::Crc64> hout(out, block_size);
+
+        hout.Write(sample.data(), sample.size());
+    }
+
+    std::vector<uint8_t> result(sample.size());
+
+    {
+        awl::StopWatch w;
+
+        VectorInputStream in(v);
+
+        HashInputStream<awl::crypto::Crc64> hin(in, block_size);
+
+        ReadRaw(hin, result.data(), result.size());
+
+        context.logger.debug(_T("Sequential verification: "));
+
+        helpers::ReportSpeed(context, w, v.size());
+    }
+
+    {
+        awl::StopWatch w;
+
+        ParallelHashInputStream<awl::crypto::Crc64> hin(std::span<const uint8_t>(v), block_size);
+
+        ReadRaw(hin, result.data(), result.size());
+
+        context.logger.debug(awl::format() << _T("Parallel verification with ") << awl::DefaultThreadCount() << _T(" threads: "));
+
+        helpers::ReportSpeed(context, w, v.size());
+    }
+
+    AWL_ASSERT(result == sample);
+}
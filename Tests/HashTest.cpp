@@ -9,6 +9,8 @@
 #include <set>
 #include <memory>
 #include <ranges>
+#include <list>
+#include <thread>
 
 #ifdef AWL_OPENSSL_HASH
 #include "Awl/Crypto/OpenSslHash.h"
@@ -19,7 +21,12 @@
 #include "Awl/StringFormat.h"
 
 #include "Awl/StopWatch.h"
+#include "Awl/Random.h"
+#include "Awl/Hashable.h"
+#include "Awl/Tuplizable.h"
 #include "Awl/Crypto/Crc64.h"
+#include "Awl/Crypto/ParallelCrc64.h"
+#include "Awl/Crypto/FastHash.h"
 #include "Awl/Crypto/FixedHash.h"
 
 #include "Awl/Testing/UnitTest.h"
@@ -185,6 +192,8 @@ AWL_BENCHMARK(HashPerformance)
     using namespace awl::crypto;
 
     CalcHash<Crc64>(context, _T("Crc64"));
+    CalcHash<FastHash64>(context, _T("FastHash64"));
+    CalcHash<FastHash128>(context, _T("FastHash128"));
 
 #ifdef AWL_OPENSSL_HASH
 
@@ -295,3 +304,289 @@ AWL_TEST(Hash_Fake)
 
     Assert::IsTrue(hash(sample1.begin(), sample1.end()) == hash(sample2.begin(), sample2.end()));
 }
+
+namespace
+{
+    using Crc64Kernel = uint64_t (*)(uint64_t crc, const uint8_t* p, size_t size);
+
+    std::vector<std::pair<const awl::Char*, Crc64Kernel>> GetCrc64Kernels()
+    {
+        using awl::crypto::Crc64;
+
+        std::vector<std::pair<const awl::Char*, Crc64Kernel>> kernels =
+        {
+            { _T("bytes"), &Crc64::UpdateBytes },
+            { _T("slicing-by-8"), &Crc64::UpdateSlicing8 },
+            { _T("slicing-by-16"), &Crc64::UpdateSlicing16 }
+        };
+
+#ifdef AWL_CRC64_CLMUL
+        if (Crc64::HasClmul())
+        {
+            kernels.emplace_back(_T("clmul"), &Crc64::UpdateClmul);
+        }
+#endif
+
+        return kernels;
+    }
+}
+
+AWL_TEST(Hash_Crc64Kernels)
+{
+    AWL_UNUSED_CONTEXT;
+
+    using awl::crypto::Crc64;
+
+    std::vector<uint8_t> v(5000);
+
+    for (size_t i = 0; i < v.size(); ++i)
+    {
+        v[i] = static_cast<uint8_t>(i * 7 + i / 13);
+    }
+
+    //The check value of the Jones variant with zero seed.
+    AWL_ASSERT_EQUAL(UINT64_C(0xe9c6d914c4b8d9ca), Crc64::Update(0, reinterpret_cast<const uint8_t*>(sampleString), 9));
+
+    for (const auto& p : GetCrc64Kernels())
+    {
+        const Crc64Kernel kernel = p.second;
+
+        //Different sizes and alignments.
+        for (size_t offset : { 0, 1, 7 })
+        {
+            for (size_t size : { 0, 1, 8, 15, 16, 17, 31, 32, 33, 63, 64, 127, 128, 129, 200, 1000, 4000 })
+            {
+                const uint8_t* p = v.data() + offset;
+
+                const uint64_t expected = Crc64::UpdateBytes(127, p, size);
+
+                AWL_ASSERT(kernel(127, p, size) == expected);
+
+                //Splitting the data does not change the result.
+                AWL_ASSERT(kernel(kernel(127, p, size / 3), p + size / 3, size - size / 3) == expected);
+            }
+        }
+    }
+
+    //The contiguous ranges of wider types are hashed by their bytes.
+    const std::vector<uint32_t> ints = { 1, 2, 3, 0xFFFFFFFF, 5 };
+    const std::list<uint32_t> list(ints.begin(), ints.end());
+
+    const Crc64 hash;
+
+    AWL_ASSERT(hash(ints.begin(), ints.end()) == hash(list.begin(), list.end()));
+}
+
+//./AwlTest --filter Hash_Crc64Throughput.* --output all
+AWL_BENCHMARK(Hash_Crc64Throughput)
+{
+    AWL_ATTRIBUTE(size_t, total_size, 100000000);
+
+    std::vector<uint8_t> v(1024 * 1024);
+
+    for (size_t i = 0; i < v.size(); ++i)
+    {
+        v[i] = static_cast<uint8_t>(i);
+    }
+
+    for (size_t buffer_size : { 16, 64, 256, 4 * 1024, 64 * 1024, 1024 * 1024 })
+    {
+        const size_t iteration_count = std::max(total_size / buffer_size, static_cast<size_t>(1));
+
+        for (auto [name, kernel] : GetCrc64Kernels())
+        {
+            awl::StopWatch w;
+
+            uint64_t crc = 0;
+
+            for (size_t i = 0; i < iteration_count; ++i)
+            {
+                crc = kernel(crc, v.data(), buffer_size);
+            }
+
+            context.logger.debug(awl::format() << name << _T(", ") << buffer_size << _T(" bytes (") << crc << _T("): "));
+
+            ReportSpeed(context, w, iteration_count * buffer_size);
+        }
+    }
+}
+
+AWL_TEST(Hash_Crc64Combine)
+{
+    AWL_UNUSED_CONTEXT;
+
+    using awl::crypto::Crc64;
+
+    std::vector<uint8_t> v(100000);
+
+    std::uniform_int_distribution<int> dist(0, 255);
+
+    for (uint8_t& b : v)
+    {
+        b = static_cast<uint8_t>(dist(awl::random()));
+    }
+
+    for (size_t size : { 0, 1, 15, 16, 1000, 65536, 100000 })
+    {
+        const uint64_t expected = Crc64::Update(127, v.data(), size);
+
+        for (size_t split : { static_cast<size_t>(0), size / 3, size / 2, size })
+        {
+            const uint64_t crc_a = Crc64::Update(127, v.data(), split);
+
+            const uint64_t crc_b = Crc64::Update(0, v.data() + split, size - split);
+
+            AWL_ASSERT(Crc64::Combine(crc_a, crc_b, size - split) == expected);
+        }
+
+        //The same data followed by zeros.
+        std::vector<uint8_t> zeros(size);
+
+        AWL_ASSERT(Crc64::Shift(expected, size) == Crc64::Update(expected, zeros.data(), size));
+
+        for (size_t thread_count : { 1, 2, 3, 8 })
+        {
+            const awl::crypto::ParallelCrc64 parallel_hash(127, thread_count, 100);
+
+            AWL_ASSERT(parallel_hash(v.begin(), v.begin() + size) == Crc64()(v.begin(), v.begin() + size));
+        }
+    }
+}
+
+//./AwlTest --filter Hash_ParallelCrc64Throughput.* --output all --thread_count 4
+AWL_BENCHMARK(Hash_ParallelCrc64Throughput)
+{
+    AWL_ATTRIBUTE(size_t, buffer_size, 256 * 1024 * 1024);
+    AWL_ATTRIBUTE(size_t, thread_count, std::thread::hardware_concurrency());
+
+    std::vector<uint8_t> v(buffer_size);
+
+    for (size_t i = 0; i < v.size(); ++i)
+    {
+        v[i] = static_cast<uint8_t>(i);
+    }
+
+    uint64_t expected;
+
+    {
+        awl::StopWatch w;
+
+        expected = awl::crypto::Crc64::Update(127, v.data(), v.size());
+
+        context.logger.debug(_T("Crc64: "));
+
+        ReportSpeed(context, w, v.size());
+    }
+
+    {
+        const awl::crypto::ParallelCrc64 hash(127, thread_count);
+
+        awl::StopWatch w;
+
+        const uint64_t actual = hash.Update(127, v.data(), v.size());
+
+        context.logger.debug(awl::format() << _T("ParallelCrc64, ") << thread_count << _T(" threads: "));
+
+        ReportSpeed(context, w, v.size());
+
+        AWL_ASSERT(actual == expected);
+    }
+}
+
+AWL_TEST(Hash_FastHash)
+{
+    AWL_UNUSED_CONTEXT;
+
+    using awl::crypto::FastHashFunctions;
+
+    std::vector<uint8_t> v(3000);
+
+    std::uniform_int_distribution<int> dist(0, 255);
+
+    for (uint8_t& b : v)
+    {
+        b = static_cast<uint8_t>(dist(awl::random()));
+    }
+
+    std::set<uint64_t> values;
+
+    for (size_t size = 0; size < 2100; size += size < 300 ? 1 : 61)
+    {
+        for (size_t offset : { 0, 3 })
+        {
+            const uint8_t* p = v.data() + offset;
+
+            const uint64_t val = FastHashFunctions::Hash64(p, size, 5);
+
+            //The vector kernel does not change the value.
+            AWL_ASSERT(val == FastHashFunctions::Hash64Scalar(p, size, 5));
+
+            //The low half of the 128 bit value.
+            AWL_ASSERT(val == FastHashFunctions::Hash128(p, size, 5)[0]);
+
+            values.insert(val);
+
+            values.insert(FastHashFunctions::Hash64(p, size, 6));
+
+            //Each bit of the data affects the value.
+            if (size != 0)
+            {
+                std::vector<uint8_t> changed(p, p + size);
+
+                changed[size / 2] ^= 1;
+
+                AWL_ASSERT(val != FastHashFunctions::Hash64(changed.data(), size, 5));
+            }
+        }
+    }
+
+    //Different sizes, offsets and seeds.
+    AWL_ASSERT(values.size() > 1000);
+
+    //The bytes of a non-contiguous range are the same.
+    const std::vector<uint32_t> ints = { 1, 2, 3, 0xFFFFFFFF, 5 };
+    const std::list<uint32_t> list(ints.begin(), ints.end());
+
+    const awl::crypto::FastHash128 hash;
+
+    AWL_ASSERT(hash(ints.begin(), ints.end()) == hash(list.begin(), list.end()));
+}
+
+namespace
+{
+    struct HashKey
+    {
+        int32_t a;
+        int32_t b;
+        std::string name;
+
+        AWL_TUPLIZABLE(a, b, name)
+    };
+}
+
+AWL_TEST(Hash_FastHashTuplizable)
+{
+    AWL_UNUSED_CONTEXT;
+
+    const awl::fast_hash<HashKey> hash;
+
+    AWL_ASSERT(hash(HashKey{ 1, 2, "abc" }) == hash(HashKey{ 1, 2, "abc" }));
+    AWL_ASSERT(hash(HashKey{ 1, 2, "abc" }) != hash(HashKey{ 2, 1, "abc" }));
+    AWL_ASSERT(hash(HashKey{ 1, 2, "abc" }) != hash(HashKey{ 1, 2, "abd" }));
+
+    //The low bits of sequential keys are spread as random ones, where about 63% of the buckets are occupied.
+    const size_t bucket_count = 1 << 16;
+
+    std::set<size_t> buckets;
+
+    for (int32_t i = 0; i < static_cast<int32_t>(bucket_count); ++i)
+    {
+        buckets.insert(hash(HashKey{ i, 0, {} }) & (bucket_count - 1));
+    }
+
+    AWL_ASSERT(buckets.size() > bucket_count * 6 / 10);
+
+    const awl::fast_hash<std::vector<HashKey>> vector_hash;
+
+    AWL_ASSERT(vector_hash({ HashKey{ 1, 2, "abc" } }) != vector_hash({ HashKey{ 1, 2, "abc" }, HashKey{ 1, 2, "abc" } }));
+}
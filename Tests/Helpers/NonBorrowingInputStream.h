@@ -0,0 +1,39 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Awl/Io/SequentialStream.h"
+#include "Awl/Io/VectorStream.h"
+
+#include <vector>
+#include <cstdint>
+
+namespace awl::testing::helpers
+{
+    //Does not lend its bytes, so the readers take the path that copies them.
+    class NonBorrowingInputStream : public awl::io::SequentialInputStream
+    {
+    public:
+
+        NonBorrowingInputStream(const std::vector<uint8_t>& v) : m_in(v)
+        {
+        }
+
+        bool End() override
+        {
+            return m_in.End();
+        }
+
+        size_t Read(uint8_t* buffer, size_t count) override
+        {
+            return m_in.Read(buffer, count);
+        }
+
+    private:
+
+        awl::io::VectorInputStream m_in;
+    };
+}
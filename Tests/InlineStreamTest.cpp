@@ -0,0 +1,242 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Awl/Io/InlineStream.h"
+#include "Awl/Io/BufferedStream.h"
+#include "Awl/Io/VectorStream.h"
+#include "Awl/Io/ReadWrite.h"
+
+#include "Awl/Random.h"
+#include "Awl/StopWatch.h"
+#include "Awl/Tuplizable.h"
+
+#include "Awl/Testing/UnitTest.h"
+
+#include "Helpers/BenchmarkHelpers.h"
+
+#include <vector>
+#include <numeric>
+
+using namespace awl::testing;
+
+namespace
+{
+    struct Fields
+    {
+        int32_t a;
+        int64_t b;
+        uint16_t c;
+        double d;
+        int32_t e;
+        uint8_t f;
+        int64_t g;
+        float h;
+
+        AWL_TUPLIZABLE(a, b, c, d, e, f, g, h)
+    };
+
+    AWL_MEMBERWISE_EQUATABLE(Fields)
+
+    constexpr size_t fieldCount = 8;
+
+    Fields MakeFields(size_t i)
+    {
+        return Fields{ static_cast<int32_t>(i), static_cast<int64_t>(i) * 3, static_cast<uint16_t>(i),
+            static_cast<double>(i) / 2, -static_cast<int32_t>(i), static_cast<uint8_t>(i), static_cast<int64_t>(i) << 20, 1.5f };
+    }
+
+    template <class OutputStream>
+    void WriteFields(OutputStream& out, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            awl::io::Write(out, MakeFields(i));
+        }
+    }
+
+    template <class InputStream>
+    void ReadFields(InputStream& in, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            Fields val;
+
+            awl::io::Read(in, val);
+
+            AWL_ASSERT(val == MakeFields(i));
+        }
+
+        AWL_ASSERT(in.End());
+    }
+}
+
+AWL_TEST(InlineStreamReadWrite)
+{
+    AWL_UNUSED_CONTEXT;
+
+    AWL_ATTRIBUTE(size_t, iteration_count, 100);
+
+    for (size_t buffer_size : { 1, 7, 64, 1000 })
+    {
+        std::vector<uint8_t> sample(10000);
+
+        std::iota(sample.begin(), sample.end(), static_cast<uint8_t>(0));
+
+        std::uniform_int_distribution<size_t> dist(0, buffer_size * 2);
+
+        std::vector<uint8_t> v;
+
+        {
+            awl::io::VectorOutputStream out(v);
+
+            awl::io::InlineOutputStream inline_out(out, buffer_size);
+
+            for (size_t pos = 0; pos != sample.size();)
+            {
+                const size_t count = std::min(dist(awl::random()), sample.size() - pos);
+
+                inline_out.Write(sample.data() + pos, count);
+
+                pos += count;
+            }
+        }
+
+        AWL_ASSERT(v == sample);
+
+        awl::io::VectorInputStream in(v);
+
+        awl::io::InlineInputStream inline_in(in, buffer_size);
+
+        std::vector<uint8_t> actual;
+
+        for (size_t i = 0; i < iteration_count && !inline_in.End(); ++i)
+        {
+            const size_t count = dist(awl::random());
+
+            if (const uint8_t* p = inline_in.Borrow(count))
+            {
+                //Everything that fits into the buffer can be borrowed.
+                AWL_ASSERT(count <= buffer_size);
+
+                actual.insert(actual.end(), p, p + count);
+            }
+            else
+            {
+                std::vector<uint8_t> buffer(count);
+
+                buffer.resize(inline_in.Read(buffer.data(), count));
+
+                actual.insert(actual.end(), buffer.begin(), buffer.end());
+            }
+        }
+
+        std::vector<uint8_t> tail(sample.size());
+
+        tail.resize(inline_in.Read(tail.data(), tail.size()));
+
+        actual.insert(actual.end(), tail.begin(), tail.end());
+
+        AWL_ASSERT(inline_in.End());
+        AWL_ASSERT(actual == sample);
+    }
+}
+
+AWL_TEST(InlineStreamFields)
+{
+    AWL_UNUSED_CONTEXT;
+
+    const size_t count = 1000;
+
+    std::vector<uint8_t> v;
+
+    {
+        awl::io::VectorOutputStream out(v);
+
+        awl::io::InlineOutputStream inline_out(out, 100);
+
+        WriteFields(inline_out, count);
+    }
+
+    awl::io::VectorInputStream in(v);
+
+    awl::io::InlineInputStream inline_in(in, 100);
+
+    ReadFields(inline_in, count);
+}
+
+//./AwlTest --filter InlineStreamFieldBenchmark.* --output all --element_count 10000000
+AWL_BENCHMARK(InlineStreamFieldBenchmark)
+{
+    AWL_ATTRIBUTE(size_t, element_count, 1000000);
+
+    std::vector<uint8_t> v;
+
+    v.reserve(element_count * 64);
+
+    auto report = [&](const awl::Char* name, const awl::StopWatch& w)
+    {
+        context.logger.debug(name);
+        helpers::ReportCountAndSpeed(context, w, element_count * fieldCount, v.size());
+    };
+
+    {
+        v.clear();
+
+        awl::io::VectorOutputStream out(v);
+
+        awl::StopWatch w;
+
+        {
+            awl::io::BufferedOutputStream buffered_out(out);
+
+            WriteFields(buffered_out, element_count);
+        }
+
+        report(_T("Write fields, BufferedOutputStream: "), w);
+    }
+
+    {
+        v.clear();
+
+        awl::io::VectorOutputStream out(v);
+
+        awl::StopWatch w;
+
+        {
+            awl::io::InlineOutputStream inline_out(out);
+
+            WriteFields(inline_out, element_count);
+        }
+
+        report(_T("Write fields, InlineOutputStream: "), w);
+    }
+
+    {
+        awl::io::VectorInputStream in(v);
+
+        awl::StopWatch w;
+
+        //There is no hash, so the data written by InlineOutputStream can't be read by BufferedInputStream.
+        awl::io::InlineInputStream<awl::io::SequentialInputStream> virtual_in(in);
+
+        awl::io::SequentialInputStream& s = virtual_in;
+
+        ReadFields(s, element_count);
+
+        report(_T("Read fields, virtual calls: "), w);
+    }
+
+    {
+        awl::io::VectorInputStream in(v);
+
+        awl::StopWatch w;
+
+        awl::io::InlineInputStream inline_in(in);
+
+        ReadFields(inline_in, element_count);
+
+        report(_T("Read fields, InlineInputStream: "), w);
+    }
+}
@@ -0,0 +1,374 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Awl/IntervalMap.h"
+#include "Awl/Testing/UnitTest.h"
+#include "Awl/Random.h"
+#include "Awl/StopWatch.h"
+
+#include "Helpers/BenchmarkHelpers.h"
+
+#include <map>
+#include <ranges>
+
+using Map = std::map<int, std::string>;
+
+using IntervalMap = awl::interval_map<int, std::string>;
+
+static_assert(std::ranges::range<Map>);
+static_assert(std::ranges::range<IntervalMap>);
+static_assert(std::bidirectional_iterator<IntervalMap::const_iterator>);
+
+using namespace awl::testing;
+
+namespace
+{
+    //Adjacent intervals with equal values should be merged.
+    void AssertMerged(const IntervalMap& map)
+    {
+        const auto v = map.intervals();
+
+        for (size_t i = 1; i < v.size(); ++i)
+        {
+            AWL_ASSERT(v[i - 1].right < v[i].left);
+            AWL_ASSERT(v[i - 1].right + 1 != v[i].left || v[i - 1].value != v[i].value);
+        }
+    }
+}
+
+AWL_TEST(IntervalMapIterator)
+{
+    AWL_UNUSED_CONTEXT;
+
+    IntervalMap actual_map;
+
+    {
+        auto begin = actual_map.begin();
+        auto end = actual_map.end();
+
+        AWL_ASSERT(begin == end);
+    }
+
+    actual_map.assign(1, 3, "a");
+
+    actual_map.assign(5, 6, "b");
+
+    {
+        auto begin = actual_map.begin();
+        auto end = actual_map.end();
+
+        AWL_ASSERT(begin != end);
+
+        IntervalMap::const_iterator i = begin;
+
+        //auto val = (*i).first;
+        //auto val = (*i++).first;
+        
+        AWL_ASSERT((*i).second == "a");
+        AWL_ASSERT(i != end && (*i++).first == 1);
+        AWL_ASSERT((*i).second == "a");
+        AWL_ASSERT(i != end && (*i++).first == 2);
+        AWL_ASSERT((*i).second == "a");
+        AWL_ASSERT(i != end && (*i++).first == 3);
+
+        AWL_ASSERT((*i).second == "b");
+        AWL_ASSERT(i != end && (*i++).first == 5);
+        AWL_ASSERT((*i).second == "b");
+        AWL_ASSERT(i != end && (*i++).first == 6);
+
+        AWL_ASSERT(i == end);
+
+        AWL_ASSERT((*--i).first == 6);
+        AWL_ASSERT((*--i).first == 5);
+        AWL_ASSERT((*--i).first == 3);
+        AWL_ASSERT((*--i).second == "a");
+        AWL_ASSERT((*--i).first == 1);
+        AWL_ASSERT(i == begin);
+    }
+
+    AWL_ASSERT(std::ranges::equal(actual_map | std::views::reverse | std::views::keys, std::vector{ 6, 5, 3, 2, 1 }));
+}
+
+AWL_TEST(IntervalMapQuery)
+{
+    AWL_UNUSED_CONTEXT;
+
+    IntervalMap map;
+
+    map.assign(1, 3, "a");
+    map.assign(5, 6, "b");
+    map.assign(7, 9, "b");
+    map.assign(12, 20, "c");
+
+    AWL_ASSERT_EQUAL(static_cast<size_t>(3), map.interval_count());
+
+    AWL_ASSERT(map.find(0) == map.interval_end());
+    AWL_ASSERT(map.find(4) == map.interval_end());
+    AWL_ASSERT(map.find(21) == map.interval_end());
+
+    {
+        auto i = map.find(8);
+
+        AWL_ASSERT(i != map.interval_end());
+        AWL_ASSERT(i->left == 5 && i->right == 9 && i->value == "b");
+    }
+
+    AWL_ASSERT(map.overlapping(10, 11).empty());
+    AWL_ASSERT(map.overlapping(21, 30).empty());
+    AWL_ASSERT_EQUAL(static_cast<ptrdiff_t>(1), std::ranges::distance(map.overlapping(3, 4)));
+    AWL_ASSERT_EQUAL(static_cast<ptrdiff_t>(3), std::ranges::distance(map.overlapping(0, 12)));
+    AWL_ASSERT(map.overlapping(6, 15).front().value == "b");
+    AWL_ASSERT(map.overlapping(6, 15).back().value == "c");
+
+    //Splits [12, 20].
+    map.assign(15, 16, "d");
+
+    AWL_ASSERT_EQUAL(static_cast<size_t>(5), map.interval_count());
+    AWL_ASSERT(map.at(14) == "c" && map.at(15) == "d" && map.at(17) == "c");
+
+    //Merges everything.
+    map.assign(0, 30, "e");
+
+    AWL_ASSERT_EQUAL(static_cast<size_t>(1), map.interval_count());
+
+    AWL_ASSERT_FALSE(map.contains(31));
+
+    try
+    {
+        map.at(31);
+
+        AWL_FAILM(_T("at() did not throw."));
+    }
+    catch (const std::out_of_range&)
+    {
+    }
+}
+
+AWL_TEST(IntervalMapBulkAssign)
+{
+    AWL_UNUSED_CONTEXT;
+
+    AWL_ATTRIBUTE(int, range, 1000);
+    AWL_ATTRIBUTE(size_t, iteration_count, 100);
+    AWL_ATTRIBUTE(size_t, interval_count, 20);
+
+    IntervalMap expected_map;
+    IntervalMap actual_map;
+
+    std::uniform_int_distribution<int> len_dist(0, range / static_cast<int>(interval_count));
+    std::uniform_int_distribution<int> value_dist(0, 3);
+
+    for (size_t i = 0; i < iteration_count; ++i)
+    {
+        std::vector<IntervalMap::interval_type> v;
+
+        //Sorted intervals go to the single pass merge.
+        const bool ordered = i % 2 == 0;
+
+        int key = len_dist(awl::random());
+
+        for (size_t j = 0; j < interval_count; ++j)
+        {
+            const int a = ordered ? key : std::uniform_int_distribution<int>(0, range)(awl::random());
+            const int b = a + len_dist(awl::random());
+
+            v.push_back({ a, b, std::string(1, static_cast<char>('A' + value_dist(awl::random()))) });
+
+            key = b + 1 + len_dist(awl::random()) % 2;
+        }
+
+        for (const auto& interval : v)
+        {
+            expected_map.assign(interval.left, interval.right, interval.value);
+        }
+
+        actual_map.assign(v);
+
+        AWL_ASSERT(actual_map == expected_map);
+        AssertMerged(actual_map);
+    }
+}
+
+AWL_TEST(IntervalMap)
+{
+    AWL_UNUSED_CONTEXT;
+    
+    AWL_ATTRIBUTE(int, range, 1000);
+    AWL_ATTRIBUTE(size_t, iteration_count, 100);
+    AWL_ATTRIBUTE(size_t, clear_count, 50);
+
+    Map expected_map;
+
+    IntervalMap actual_map;
+
+    auto assert_equal = [&actual_map, &expected_map]()
+    {
+        // They are of a different types.
+        auto pred = [](const IntervalMap::value_type& actual_pair, const Map::value_type& expected_pair) -> bool
+        {
+            return actual_pair.first == expected_pair.first && actual_pair.second == expected_pair.second;
+        };
+
+        AWL_ASSERT(std::ranges::equal(actual_map, expected_map, pred));
+    };
+
+    auto assign = [&expected_map, &actual_map, &assert_equal](int a, int b, std::string value)
+    {
+        //context.out << _T("Assigning: [") << a << _T(", ") << b << "] = " << awl::FromAString(value) << std::endl;
+        
+        // value is moved here
+        actual_map.assign(a, b, value);
+
+        for (int i = a; i <= b; ++i)
+        {
+            AWL_ASSERT(actual_map.at(i) == value);
+
+            expected_map[i] = value;
+        }
+
+        //size_t index = 0;
+        
+        //for (auto [key, val] : actual_map)
+        //{
+        //    context.out << _T("#") << index++ << _T("\t") << key << _T(" => ") << awl::FromAString(val) << std::endl;
+        //}
+
+        assert_equal();
+    };
+
+    auto clear = [&expected_map, &actual_map, &assert_equal]()
+    {
+        actual_map.clear();
+        expected_map.clear();
+
+        assert_equal();
+    };
+
+    assert_equal();
+
+    //assign(1, 5, "a");
+
+    //assign(5, 6, "b");
+
+    //assign(3, 3, "c");
+
+    //assign(0, 10, "d");
+
+    //assign(5, 6, "e");
+
+    //assign(12, 13, "f");
+
+    //assign(3, 5, "g");
+
+    std::uniform_int_distribution<int> a_dist(0, range);
+
+    for (size_t i = 0; i < iteration_count; ++i)
+    {
+        if (iteration_count % clear_count == 0)
+        {
+            clear();
+        }
+
+        const int a = a_dist(awl::random());
+
+        std::uniform_int_distribution<int> len_dist(0, range - a);
+
+        const int len = len_dist(awl::random());
+
+        const char ch = 'A' + (i % ('Z' - 'A'));
+
+        std::string val(1, ch);
+
+        assign(a, a + len, val);
+
+        AssertMerged(actual_map);
+    }
+}
+
+namespace
+{
+    template <class Func>
+    void MeasureAssign(const TestContext& context, const awl::Char* name, size_t count, Func&& func)
+    {
+        AWL_ATTRIBUTE(size_t, iteration_count, 10);
+
+        awl::StopWatch w;
+
+        size_t interval_count = 0;
+
+        for (size_t i = 0; i < iteration_count; ++i)
+        {
+            IntervalMap map;
+
+            func(map);
+
+            interval_count += map.interval_count();
+        }
+
+        context.logger.debug(awl::format() << name << _T(" (") << interval_count / iteration_count << _T(" intervals): "));
+
+        helpers::ReportCount(context, w, count * iteration_count);
+    }
+}
+
+AWL_BENCHMARK(IntervalMapAssign)
+{
+    AWL_ATTRIBUTE(size_t, element_count, 10000);
+    AWL_ATTRIBUTE(int, max_length, 10);
+
+    std::vector<IntervalMap::interval_type> random_v;
+    std::vector<IntervalMap::interval_type> sequential_v;
+
+    {
+        const int range = static_cast<int>(element_count) * max_length;
+
+        std::uniform_int_distribution<int> key_dist(0, range);
+        std::uniform_int_distribution<int> len_dist(0, max_length - 1);
+        std::uniform_int_distribution<int> value_dist(0, 9);
+
+        int key = 0;
+
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            const int len = len_dist(awl::random());
+
+            std::string value(1, static_cast<char>('0' + value_dist(awl::random())));
+
+            const int a = key_dist(awl::random());
+
+            random_v.push_back({ a, a + len, value });
+
+            sequential_v.push_back({ key, key + len, std::move(value) });
+
+            key += len + 1;
+        }
+    }
+
+    MeasureAssign(context, _T("random"), element_count, [&random_v](IntervalMap& map)
+    {
+        for (const auto& v : random_v)
+        {
+            map.assign(v.left, v.right, v.value);
+        }
+    });
+
+    MeasureAssign(context, _T("sequential"), element_count, [&sequential_v](IntervalMap& map)
+    {
+        for (const auto& v : sequential_v)
+        {
+            map.assign(v.left, v.right, v.value);
+        }
+    });
+
+    MeasureAssign(context, _T("sequential bulk"), element_count, [&sequential_v](IntervalMap& map)
+    {
+        map.assign(sequential_v);
+    });
+
+    MeasureAssign(context, _T("random bulk"), element_count, [&random_v](IntervalMap& map)
+    {
+        map.assign(random_v);
+    });
+}
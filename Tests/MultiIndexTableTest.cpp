@@ -0,0 +1,256 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Awl/MultiIndexTable.h"
+#include "Awl/MirrorSet.h"
+#include "Awl/Testing/UnitTest.h"
+#include "Awl/Random.h"
+#include "Awl/KeyCompare.h"
+#include "Awl/Tuplizable.h"
+#include "Awl/StopWatch.h"
+
+#include "Helpers/BenchmarkHelpers.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <ranges>
+
+using namespace awl::testing;
+
+namespace
+{
+    struct A
+    {
+        int id;
+        std::string name;
+        int rank;
+
+        AWL_TUPLIZABLE(id, name, rank)
+    };
+
+    AWL_MEMBERWISE_EQUATABLE(A)
+
+    using Table = awl::multi_index_table<A,
+        awl::ordered_index<awl::getter<&A::id>>,
+        awl::hashed_index<awl::getter<&A::name>>,
+        awl::ranked_index<awl::getter<&A::rank>>>;
+
+    static_assert(std::ranges::range<Table>);
+
+    std::string MakeName(int val)
+    {
+        return "name" + std::to_string(val);
+    }
+
+    //The table is equal to the reference map if all the indices contain the same elements.
+    void AssertEqual(const Table& table, const std::map<int, A>& expected)
+    {
+        AWL_ASSERT_EQUAL(expected.size(), table.size());
+        AWL_ASSERT_EQUAL(expected.size(), table.get<1>().size());
+        AWL_ASSERT_EQUAL(expected.size(), table.get<2>().size());
+
+        AWL_ASSERT(std::ranges::equal(table, expected | std::views::values));
+
+        std::vector<A> by_rank(expected.size());
+        std::ranges::copy(expected | std::views::values, by_rank.begin());
+        std::ranges::sort(by_rank, {}, &A::rank);
+
+        for (size_t i = 0; i < by_rank.size(); ++i)
+        {
+            const A& a = by_rank[i];
+
+            AWL_ASSERT(table.get<2>()[i] == a);
+            AWL_ASSERT_EQUAL(i, table.get<2>().index_of(a.rank));
+
+            auto name_i = table.get<1>().find(a.name);
+            AWL_ASSERT(name_i != table.get<1>().end());
+            AWL_ASSERT(*name_i == a);
+        }
+
+        AWL_ASSERT_EQUAL(expected.size(), static_cast<size_t>(std::ranges::distance(table.get<1>())));
+        AWL_ASSERT(std::ranges::equal(table.get<2>(), by_rank));
+    }
+}
+
+AWL_TEST(MultiIndexTableInsertErase)
+{
+    AWL_UNUSED_CONTEXT;
+
+    AWL_ATTRIBUTE(size_t, insert_count, 1000);
+    AWL_ATTRIBUTE(int, range, 1000);
+
+    Table table;
+    std::map<int, A> expected;
+
+    std::uniform_int_distribution<int> dist(1, range);
+
+    for (size_t i = 0; i < insert_count; ++i)
+    {
+        const int id = dist(awl::random());
+        const int name_val = dist(awl::random());
+        const int rank = dist(awl::random());
+
+        const A a{ id, MakeName(name_val), rank };
+
+        const bool unique = !expected.contains(id) &&
+            std::ranges::none_of(expected | std::views::values, [&a](const A& b) { return b.name == a.name || b.rank == a.rank; });
+
+        auto [table_i, inserted] = table.insert(a);
+
+        AWL_ASSERT_EQUAL(unique, inserted);
+
+        if (inserted)
+        {
+            AWL_ASSERT(*table_i == a);
+            expected.emplace(id, a);
+        }
+    }
+
+    AssertEqual(table, expected);
+
+    for (size_t i = 0; i < insert_count / 4; ++i)
+    {
+        const int id = dist(awl::random());
+
+        AWL_ASSERT_EQUAL(expected.erase(id), table.erase(id));
+    }
+
+    AssertEqual(table, expected);
+
+    //Erase by the hashed and ranked indices.
+    while (table.size() > expected.size() / 2)
+    {
+        const A a = table.get<2>().at(table.size() / 2);
+
+        if (table.size() % 2 == 0)
+        {
+            table.erase(table.get<1>().find(a.name));
+        }
+        else
+        {
+            AWL_ASSERT_EQUAL(static_cast<size_t>(1), table.erase<2>(a.rank));
+        }
+
+        expected.erase(a.id);
+    }
+
+    AssertEqual(table, expected);
+
+    table.clear();
+    expected.clear();
+
+    AssertEqual(table, expected);
+    AWL_ASSERT(table.get<1>().find(MakeName(1)) == table.get<1>().end());
+}
+
+AWL_TEST(MultiIndexTableCopyMove)
+{
+    AWL_UNUSED_CONTEXT;
+
+    Table table{ { 1, "a", 30 }, { 2, "b", 20 }, { 3, "c", 10 } };
+
+    AWL_ASSERT_EQUAL(static_cast<size_t>(3), table.size());
+
+    //Duplicate name.
+    AWL_ASSERT_FALSE(table.insert(A{ 4, "b", 40 }).second);
+    AWL_ASSERT_EQUAL(static_cast<size_t>(3), table.size());
+
+    Table copy = table;
+
+    AWL_ASSERT(copy == table);
+
+    Table moved = std::move(copy);
+
+    AWL_ASSERT(copy.empty());
+    AWL_ASSERT(copy.get<1>().empty());
+    AWL_ASSERT(moved == table);
+    AWL_ASSERT_EQUAL(std::string("c"), moved.get<2>().front().name);
+    AWL_ASSERT_EQUAL(static_cast<size_t>(2), moved.get<2>().index_of(moved.get<2>().find(30)));
+
+    copy = moved;
+    moved.clear();
+
+    AWL_ASSERT(copy == table);
+    AWL_ASSERT(moved.empty());
+    AWL_ASSERT(copy.get<1>().contains(std::string("a")));
+}
+
+namespace
+{
+    using Compare1 = awl::member_compare<&A::id>;
+    using Compare2 = awl::member_compare<&A::rank>;
+
+    using ObservableSet = awl::observable_set<A, Compare1>;
+    using MirrorSet = awl::mirror_set<A, Compare2>;
+
+    using OrderedTable = awl::multi_index_table<A,
+        awl::ordered_index<awl::getter<&A::id>>,
+        awl::ordered_index<awl::getter<&A::rank>>>;
+}
+
+AWL_BENCHMARK(MultiIndexTableVsMirrorSet)
+{
+    AWL_ATTRIBUTE(size_t, element_count, 100000);
+    AWL_ATTRIBUTE(size_t, iteration_count, 10);
+
+    std::vector<A> v;
+
+    for (size_t i = 0; i < element_count; ++i)
+    {
+        const int val = static_cast<int>(i);
+
+        v.push_back(A{ val, MakeName(val), val });
+    }
+
+    std::ranges::shuffle(v, awl::random());
+
+    {
+        awl::StopWatch w;
+
+        for (size_t i = 0; i < iteration_count; ++i)
+        {
+            ObservableSet set;
+            MirrorSet mirror;
+
+            mirror.reflect(set);
+
+            for (const A& a : v)
+            {
+                set.insert(a);
+            }
+
+            for (const A& a : v)
+            {
+                set.erase(a.id);
+            }
+        }
+
+        context.logger.debug(_T("observable_set + mirror_set: "));
+        helpers::ReportCount(context, w, element_count * iteration_count);
+    }
+
+    {
+        awl::StopWatch w;
+
+        for (size_t i = 0; i < iteration_count; ++i)
+        {
+            OrderedTable table;
+
+            for (const A& a : v)
+            {
+                table.insert(a);
+            }
+
+            for (const A& a : v)
+            {
+                table.erase(a.id);
+            }
+        }
+
+        context.logger.debug(_T("multi_index_table: "));
+        helpers::ReportCount(context, w, element_count * iteration_count);
+    }
+}
@@ -7,17 +7,32 @@
 
 #include "Awl/Io/ReadWrite.h"
 #include "Awl/Io/VectorStream.h"
+#include "Awl/Io/Rw/ElementsReadWrite.h"
+#include "Awl/Io/SerializedSize.h"
+#include "Awl/Io/MeasureStream.h"
 #include "Awl/Testing/UnitTest.h"
+#include "Awl/Random.h"
+#include "Awl/StopWatch.h"
+#include "Awl/StringFormat.h"
+#include "Awl/ScopeGuard.h"
+
+#include "Tests/Helpers/BenchmarkHelpers.h"
+#include "Tests/Helpers/NonBorrowingInputStream.h"
 
 #include <iostream>
 #include <algorithm>
 #include <functional>
+#include <limits>
+#include <random>
+#include <memory_resource>
 
 using namespace std::literals;
 
 using namespace awl::testing;
 using namespace awl::io;
 
+using awl::testing::helpers::NonBorrowingInputStream;
+
 namespace
 {
     using Decimal64 = awl::decimal<uint64_t, 4>;
@@ -244,6 +259,92 @@ AWL_TEST(IoVariantReadWrite)
     helpers::TestReadWrite(context, V(5));
 }
 
+AWL_TEST(IoVariantCorruptedIndex)
+{
+    AWL_UNUSED_CONTEXT;
+
+    using V = std::variant<int, std::string>;
+
+    std::vector<uint8_t> v;
+
+    {
+        VectorOutputStream out(v);
+
+        Write(out, size_t(2));
+        Write(out, 5);
+    }
+
+    VectorInputStream in(v);
+
+    V val = std::string("abc");
+
+    try
+    {
+        Read(in, val);
+
+        AWL_FAILM("CorruptionException is not thrown.");
+    }
+    catch (const CorruptionException&)
+    {
+    }
+
+    AWL_ASSERT(std::get<std::string>(val) == "abc");
+}
+
+//./AwlTest --filter IoVariantBenchmark.* --output all --element_count 10000000
+AWL_BENCHMARK(IoVariantBenchmark)
+{
+    AWL_ATTRIBUTE(size_t, element_count, 1000000);
+
+    using V = std::variant<int8_t, int16_t, int32_t, int64_t, uint32_t, float, double, bool>;
+
+    std::vector<V> sample;
+
+    sample.reserve(element_count);
+
+    std::uniform_int_distribution<size_t> dist(0, std::variant_size_v<V> - 1);
+
+    for (size_t i = 0; i < element_count; ++i)
+    {
+        const size_t index = dist(awl::random());
+
+        awl::visit_index<std::variant_size_v<V>>(index, [&sample, i](auto index)
+        {
+            sample.push_back(V(std::in_place_index<index>, static_cast<std::variant_alternative_t<index, V>>(i % 100)));
+        });
+    }
+
+    std::vector<uint8_t> v;
+
+    {
+        VectorOutputStream out(v);
+
+        awl::StopWatch w;
+
+        Write(out, sample);
+
+        context.logger.debug(_T("Write: "));
+
+        helpers::ReportCountAndSpeed(context, w, element_count, v.size());
+    }
+
+    {
+        VectorInputStream in(v);
+
+        std::vector<V> result;
+
+        awl::StopWatch w;
+
+        Read(in, result);
+
+        context.logger.debug(_T("Read: "));
+
+        helpers::ReportCountAndSpeed(context, w, element_count, v.size());
+
+        AWL_ASSERT(result == sample);
+    }
+}
+
 template <class T>
 static void TestVector(const TestContext & context, std::vector<T> sample)
 {
@@ -284,3 +385,746 @@ AWL_TEST(IoVectorReadWrite)
     TestVector(context, std::vector<double>{});
     TestVector(context, std::vector<bool>{});
 }
+
+namespace
+{
+    template <class T>
+    size_t TestCompactReadWrite(const T& sample)
+    {
+        const CompactContext ctx;
+
+        std::vector<uint8_t> v;
+
+        {
+            VectorOutputStream out(v);
+
+            Write(out, sample, ctx);
+            Write(out, sample, ctx);
+        }
+
+        {
+            VectorInputStream in(v);
+
+            T result;
+
+            Read(in, result, ctx);
+            AWL_ASSERT(result == sample);
+
+            Read(in, result, ctx);
+            AWL_ASSERT(result == sample);
+
+            AWL_ASSERT(in.End());
+        }
+
+        {
+            NonBorrowingInputStream in(v);
+
+            T result;
+
+            Read(in, result, ctx);
+            AWL_ASSERT(result == sample);
+
+            Read(in, result, ctx);
+            AWL_ASSERT(result == sample);
+
+            AWL_ASSERT(in.End());
+        }
+
+        return v.size() / 2;
+    }
+
+    template <class T>
+    void TestCompactLimits()
+    {
+        using Limits = std::numeric_limits<T>;
+
+        for (T val : { T(0), T(1), T(63), T(64), T(127), T(128), T(300), Limits::max(), static_cast<T>(Limits::max() - 1),
+            Limits::min(), static_cast<T>(Limits::min() + 1), static_cast<T>(-1), static_cast<T>(-64), static_cast<T>(-65) })
+        {
+            TestCompactReadWrite(val);
+        }
+
+        const std::vector<T> v = { 0, 1, 2, 127, 128, Limits::max(), Limits::min(), 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13 };
+
+        TestCompactReadWrite(v);
+    }
+}
+
+AWL_TEST(IoCompactReadWrite)
+{
+    AWL_UNUSED_CONTEXT;
+
+    TestCompactLimits<int16_t>();
+    TestCompactLimits<uint16_t>();
+    TestCompactLimits<int32_t>();
+    TestCompactLimits<uint32_t>();
+    TestCompactLimits<int64_t>();
+    TestCompactLimits<uint64_t>();
+
+    //Small values take a byte.
+    AWL_ASSERT_EQUAL(size_t(1), TestCompactReadWrite(size_t(5)));
+    AWL_ASSERT_EQUAL(size_t(1), TestCompactReadWrite(int64_t(-5)));
+    AWL_ASSERT_EQUAL(size_t(10), TestCompactReadWrite(std::numeric_limits<uint64_t>::max()));
+
+    AWL_ASSERT_EQUAL(size_t(2 + 100), TestCompactReadWrite(std::vector<int64_t>(100, -7)));
+
+    TestCompactReadWrite(std::string("some sample string"));
+    TestCompactReadWrite(std::vector<std::string>{ "a1", "b123", "c12345" });
+    TestCompactReadWrite(std::map<std::string, int>{ {"a", 0}, { "b12345", -1 }, { "c12345", 1000000 } });
+    TestCompactReadWrite(std::vector<double>{ 0.0, 1.0, 2.0 });
+    TestCompactReadWrite(std::array<int, 3>{ 1, -2, 3 });
+    TestCompactReadWrite(MakeBSample());
+
+    //A value that does not fit into the type.
+    {
+        std::vector<uint8_t> v;
+
+        VectorOutputStream out(v);
+
+        Write(out, uint32_t(70000), CompactContext{});
+
+        VectorInputStream in(v);
+
+        uint16_t val;
+
+        try
+        {
+            Read(in, val, CompactContext{});
+
+            AWL_FAILM("CorruptionException is not thrown.");
+        }
+        catch (const CorruptionException&)
+        {
+        }
+    }
+}
+
+//./AwlTest --filter IoCompactVectorBenchmark.* --output all --element_count 10000000
+AWL_BENCHMARK(IoCompactVectorBenchmark)
+{
+    AWL_ATTRIBUTE(size_t, element_count, 1000000);
+    AWL_ATTRIBUTE(int64_t, max_value, 100);
+
+    std::vector<int64_t> sample(element_count);
+
+    std::uniform_int_distribution<int64_t> dist(-max_value, max_value);
+
+    for (int64_t& val : sample)
+    {
+        val = dist(awl::random());
+    }
+
+    auto test = [&](const awl::Char* name, const auto& ctx)
+    {
+        std::vector<uint8_t> v;
+
+        {
+            VectorOutputStream out(v);
+
+            awl::StopWatch w;
+
+            Write(out, sample, ctx);
+
+            context.logger.debug(awl::format() << name << _T(" write, ") << v.size() << _T(" bytes: "));
+
+            helpers::ReportCountAndSpeed(context, w, element_count, v.size());
+        }
+
+        {
+            VectorInputStream in(v);
+
+            std::vector<int64_t> result;
+
+            awl::StopWatch w;
+
+            Read(in, result, ctx);
+
+            context.logger.debug(awl::format() << name << _T(" read: "));
+
+            helpers::ReportCountAndSpeed(context, w, element_count, v.size());
+
+            AWL_ASSERT(result == sample);
+        }
+    };
+
+    test(_T("Plain"), FakeContext{});
+    test(_T("Compact"), CompactContext{});
+}
+
+namespace
+{
+    awl::generator<std::string> GenerateStrings(size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            co_yield std::to_string(i);
+        }
+    }
+
+    template <class Context>
+    void TestElements(size_t count, size_t chunk_size, const Context& ctx)
+    {
+        std::vector<uint8_t> v;
+
+        {
+            VectorOutputStream out(v);
+
+            //A range of unknown size.
+            WriteElements(out, GenerateStrings(count), ctx, chunk_size);
+
+            //A sized range.
+            std::vector<std::string> sample;
+
+            for (const std::string& val : GenerateStrings(count))
+            {
+                sample.push_back(val);
+            }
+
+            WriteElements(out, sample, ctx);
+        }
+
+        VectorInputStream in(v);
+
+        for (size_t n = 0; n < 2; ++n)
+        {
+            size_t i = 0;
+
+            for (const std::string& val : ReadElements<std::string>(in, ctx))
+            {
+                AWL_ASSERT(val == std::to_string(i++));
+            }
+
+            AWL_ASSERT_EQUAL(count, i);
+        }
+
+        AWL_ASSERT(in.End());
+    }
+}
+
+AWL_TEST(IoElementsReadWrite)
+{
+    AWL_UNUSED_CONTEXT;
+
+    for (size_t count : { 0, 1, 6, 7, 8, 1000 })
+    {
+        for (size_t chunk_size : { 1, 7, 1024 })
+        {
+            TestElements(count, chunk_size, FakeContext{});
+            TestElements(count, chunk_size, CompactContext{});
+        }
+    }
+
+    //A temporary context does not need to outlive the generator.
+    {
+        std::vector<uint8_t> v;
+
+        {
+            VectorOutputStream out(v);
+
+            WriteElements(out, GenerateStrings(10), CompactContext{});
+        }
+
+        VectorInputStream in(v);
+
+        auto elements = ReadElements<std::string>(in, CompactContext{});
+
+        size_t i = 0;
+
+        for (const std::string& val : elements)
+        {
+            AWL_ASSERT(val == std::to_string(i++));
+        }
+
+        AWL_ASSERT_EQUAL(10u, i);
+        AWL_ASSERT(in.End());
+    }
+
+    //The elements are read until the stream is broken.
+    {
+        std::vector<uint8_t> v;
+
+        {
+            VectorOutputStream out(v);
+
+            WriteElements(out, GenerateStrings(100));
+        }
+
+        v.resize(v.size() / 2);
+
+        VectorInputStream in(v);
+
+        size_t i = 0;
+
+        try
+        {
+            for (const std::string& val : ReadElements<std::string>(in))
+            {
+                AWL_ASSERT(val == std::to_string(i++));
+            }
+
+            AWL_FAILM("EndOfFileException is not thrown.");
+        }
+        catch (const EndOfFileException&)
+        {
+        }
+
+        AWL_ASSERT(i != 0);
+    }
+}
+
+namespace
+{
+    struct PmrRecord
+    {
+        std::pmr::string name;
+        std::pmr::vector<int32_t> values;
+
+        AWL_TUPLIZABLE(name, values)
+    };
+
+    AWL_MEMBERWISE_EQUATABLE(PmrRecord)
+
+    using PmrSample = std::pmr::map<std::pmr::string, std::pmr::vector<PmrRecord>>;
+
+    PmrSample MakePmrSample(size_t count, std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+    {
+        PmrSample sample(mr);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            //The strings are longer than the small string buffer.
+            std::pmr::vector<PmrRecord>& records = sample[std::pmr::string("the key number " + std::to_string(i))];
+
+            for (size_t j = 0; j < i % 5; ++j)
+            {
+                records.push_back(PmrRecord{ std::pmr::string("the record number " + std::to_string(j)), std::pmr::vector<int32_t>(j, static_cast<int32_t>(i)) });
+            }
+        }
+
+        return sample;
+    }
+
+    //Counts the allocations and forwards them to the upstream resource.
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+
+        CountingResource(std::pmr::memory_resource* upstream) : m_upstream(upstream) {}
+
+        size_t allocationCount = 0;
+
+    private:
+
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            ++allocationCount;
+
+            return m_upstream->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override
+        {
+            m_upstream->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+        std::pmr::memory_resource* m_upstream;
+    };
+}
+
+AWL_TEST(IoMemoryResourceReadWrite)
+{
+    AWL_UNUSED_CONTEXT;
+
+    static_assert(pmr_container<std::pmr::string>);
+    static_assert(pmr_container<std::pmr::vector<PmrRecord>>);
+    static_assert(pmr_container<PmrSample>);
+    static_assert(!pmr_container<std::string>);
+
+    const PmrSample sample = MakePmrSample(100);
+
+    std::vector<uint8_t> v;
+
+    {
+        VectorOutputStream out(v);
+
+        Write(out, sample);
+    }
+
+    CountingResource counter(std::pmr::new_delete_resource());
+
+    std::pmr::monotonic_buffer_resource arena(&counter);
+
+    {
+        //Nothing is allocated with the default resource while reading.
+        std::pmr::memory_resource* prev = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+
+        auto guard = awl::make_scope_guard([prev]() { std::pmr::set_default_resource(prev); });
+
+        VectorInputStream in(v);
+
+        PmrSample result;
+
+        Read(in, result, MemoryResourceContext(&arena));
+
+        AWL_ASSERT(result == sample);
+        AWL_ASSERT(result.get_allocator().resource() == &arena);
+        AWL_ASSERT(result.begin()->first.get_allocator().resource() == &arena);
+
+        for (const auto& [key, records] : result)
+        {
+            for (const PmrRecord& record : records)
+            {
+                AWL_ASSERT(record.name.get_allocator().resource() == &arena);
+                AWL_ASSERT(record.values.get_allocator().resource() == &arena);
+            }
+        }
+
+        AWL_ASSERT(counter.allocationCount != 0);
+    }
+
+    //A non-empty container keeps its memory resource.
+    {
+        VectorInputStream in(v);
+
+        PmrSample result = MakePmrSample(1);
+
+        Read(in, result, MemoryResourceContext(&arena));
+
+        AWL_ASSERT(result.get_allocator().resource() == std::pmr::get_default_resource());
+        AWL_ASSERT(result.size() == sample.size());
+    }
+
+    //A context without a memory resource.
+    {
+        VectorInputStream in(v);
+
+        PmrSample result;
+
+        Read(in, result);
+
+        AWL_ASSERT(result == sample);
+        AWL_ASSERT(result.get_allocator().resource() == std::pmr::get_default_resource());
+    }
+}
+
+//./AwlTest --filter IoMemoryResourceBenchmark.* --output all --element_count 1000000
+AWL_BENCHMARK(IoMemoryResourceBenchmark)
+{
+    AWL_ATTRIBUTE(size_t, element_count, 100000);
+
+    const PmrSample sample = MakePmrSample(element_count);
+
+    std::vector<uint8_t> v;
+
+    {
+        VectorOutputStream out(v);
+
+        Write(out, sample);
+    }
+
+    {
+        awl::StopWatch w;
+
+        {
+            VectorInputStream in(v);
+
+            PmrSample result;
+
+            Read(in, result);
+        }
+
+        context.logger.debug(_T("Default resource, load and teardown: "));
+
+        helpers::ReportCountAndSpeed(context, w, element_count, v.size());
+    }
+
+    {
+        awl::StopWatch w;
+
+        {
+            std::pmr::monotonic_buffer_resource arena;
+
+            VectorInputStream in(v);
+
+            PmrSample result;
+
+            Read(in, result, MemoryResourceContext(&arena));
+        }
+
+        context.logger.debug(_T("Monotonic arena, load and teardown: "));
+
+        helpers::ReportCountAndSpeed(context, w, element_count, v.size());
+    }
+}
+
+namespace
+{
+    struct OwningRecord
+    {
+        int64_t id;
+        std::string name;
+        std::string description;
+        std::vector<double> values;
+
+        AWL_TUPLIZABLE(id, name, description, values)
+    };
+
+    //Has the same format as OwningRecord.
+    struct ViewRecord
+    {
+        int64_t id;
+        std::string_view name;
+        std::string_view description;
+        std::span<const double> values;
+
+        AWL_TUPLIZABLE(id, name, description, values)
+    };
+
+    OwningRecord MakeOwningRecord(size_t i)
+    {
+        return OwningRecord{ static_cast<int64_t>(i), "record " + std::to_string(i),
+            "the description of the record number " + std::to_string(i), std::vector<double>(i % 10, static_cast<double>(i)) };
+    }
+
+    //The values are aligned in the buffer if the sizes of the strings are multiples of 8.
+    OwningRecord MakeAlignedRecord(size_t i)
+    {
+        OwningRecord r = MakeOwningRecord(i);
+
+        r.name.resize(16, ' ');
+        r.description.resize(48, ' ');
+
+        return r;
+    }
+
+    bool IsInside(const void* p, const std::vector<uint8_t>& v)
+    {
+        const uint8_t* byte_p = static_cast<const uint8_t*>(p);
+
+        return byte_p >= v.data() && byte_p < v.data() + v.size();
+    }
+}
+
+AWL_TEST(IoViewReadWrite)
+{
+    AWL_UNUSED_CONTEXT;
+
+    static_assert(pinned_input_stream<VectorInputStream>);
+    static_assert(pinned_input_stream<SpanInputStream>);
+    static_assert(!pinned_input_stream<SequentialInputStream>);
+
+    std::vector<OwningRecord> sample;
+
+    for (size_t i = 0; i < 100; ++i)
+    {
+        sample.push_back(MakeAlignedRecord(i));
+    }
+
+    std::vector<uint8_t> v;
+
+    {
+        VectorOutputStream out(v);
+
+        //The records are written after the size of the vector.
+        Write(out, sample);
+    }
+
+    {
+        VectorInputStream in(v);
+
+        size_t size;
+
+        Read(in, size);
+
+        AWL_ASSERT_EQUAL(sample.size(), size);
+
+        for (const OwningRecord& expected : sample)
+        {
+            ViewRecord r;
+
+            Read(in, r);
+
+            AWL_ASSERT(r.id == expected.id);
+            AWL_ASSERT(r.name == expected.name);
+            AWL_ASSERT(r.description == expected.description);
+            AWL_ASSERT(std::ranges::equal(r.values, expected.values));
+
+            AWL_ASSERT(IsInside(r.name.data(), v));
+            AWL_ASSERT(IsInside(r.description.data(), v));
+        }
+
+        AWL_ASSERT(in.End());
+    }
+
+    //The views are written in the same format.
+    {
+        std::vector<uint8_t> v1;
+
+        {
+            VectorOutputStream out(v1);
+
+            Write(out, sample.size());
+
+            for (const OwningRecord& r : sample)
+            {
+                Write(out, ViewRecord{ r.id, r.name, r.description, r.values });
+            }
+        }
+
+        AWL_ASSERT(v1 == v);
+    }
+
+    //Misaligned values.
+    {
+        v.clear();
+
+        {
+            VectorOutputStream out(v);
+
+            Write(out, uint8_t(1));
+            Write(out, std::vector<double>{ 1.0, 2.0 });
+        }
+
+        SpanInputStream in(v);
+
+        uint8_t prefix;
+
+        Read(in, prefix);
+
+        std::span<const double> values;
+
+        try
+        {
+            Read(in, values);
+
+            AWL_FAILM("IoError is not thrown.");
+        }
+        catch (const IoError&)
+        {
+        }
+    }
+
+    //The string is longer than the stream.
+    {
+        v.clear();
+
+        {
+            VectorOutputStream out(v);
+
+            Write(out, std::string("abcdef"));
+        }
+
+        v.pop_back();
+
+        VectorInputStream in(v);
+
+        std::string_view val;
+
+        try
+        {
+            Read(in, val);
+
+            AWL_FAILM("EndOfFileException is not thrown.");
+        }
+        catch (const EndOfFileException&)
+        {
+        }
+    }
+}
+
+//./AwlTest --filter IoViewBenchmark.* --output all --element_count 1000000
+AWL_BENCHMARK(IoViewBenchmark)
+{
+    AWL_ATTRIBUTE(size_t, element_count, 100000);
+
+    std::vector<uint8_t> v;
+
+    {
+        VectorOutputStream out(v);
+
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            Write(out, MakeAlignedRecord(i));
+        }
+    }
+
+    auto test = [&]<class Record>(const awl::Char* name)
+    {
+        VectorInputStream in(v);
+
+        Record r;
+
+        size_t total_length = 0;
+
+        awl::StopWatch w;
+
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            Read(in, r);
+
+            total_length += r.name.length();
+        }
+
+        context.logger.debug(awl::format() << name << _T(" read: "));
+
+        helpers::ReportCountAndSpeed(context, w, element_count, v.size());
+
+        AWL_ASSERT(total_length != 0);
+    };
+
+    test.template operator()<OwningRecord>(_T("Owning"));
+    test.template operator()<ViewRecord>(_T("View"));
+}
+
+namespace
+{
+    template <class T, class Context = FakeContext>
+    void TestSerializedSize(const T& val, const Context& ctx = {})
+    {
+        MeasureStream out;
+
+        Write(out, val, ctx);
+
+        AWL_ASSERT_EQUAL(out.GetLength(), serialized_size(val, ctx));
+    }
+}
+
+AWL_TEST(IoSerializedSize)
+{
+    AWL_UNUSED_CONTEXT;
+
+    static_assert(fixedSerializedSize<int32_t> == 4);
+    static_assert(fixedSerializedSize<bool> == 1);
+    static_assert(fixedSerializedSize<TestEnum> == sizeof(int));
+    static_assert(fixedSerializedSize<A> == sizeof(int) + sizeof(double));
+    static_assert(fixedSerializedSize<std::array<A, 3>> == 3 * (sizeof(int) + sizeof(double)));
+    static_assert(fixedSerializedSize<std::array<bool, 9>> == 2);
+    static_assert(!fixed_serialized_size<std::string>);
+    static_assert(!fixed_serialized_size<B>);
+    static_assert(!fixed_serialized_size<std::array<std::string, 2>>);
+
+    TestSerializedSize(25);
+    TestSerializedSize(true);
+    TestSerializedSize(TestEnum::B);
+    TestSerializedSize(A{ 1, 2.0 });
+    TestSerializedSize(AWrapper{ { 1, 2.0 } });
+    TestSerializedSize(std::array<bool, 9>{});
+    TestSerializedSize(std::array<A, 3>{});
+    TestSerializedSize(std::string("abc"));
+    TestSerializedSize(std::vector<bool>(13));
+    TestSerializedSize(std::vector<std::string>{ "a", "bc", "def" });
+    TestSerializedSize(std::map<std::string, std::vector<int>>{ { "a", { 1, 2 } }, { "b", {} } });
+    TestSerializedSize(std::optional<std::string>("abc"));
+    TestSerializedSize(std::variant<int, std::string>("abc"));
+    TestSerializedSize(MakeBSample());
+
+    TestSerializedSize(int64_t{ 25 }, CompactContext{});
+    TestSerializedSize(A{ 1000000, 2.0 }, CompactContext{});
+    TestSerializedSize(std::vector<int64_t>{ 1, 1000, -1000000 }, CompactContext{});
+    TestSerializedSize(std::string("abc"), LimitedContext(10));
+}
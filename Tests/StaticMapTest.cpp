@@ -0,0 +1,192 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Product: AWL (A Working Library)
+// Author: Dmitriano
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Awl/StaticMap.h"
+#include "Awl/StringFormat.h"
+#include "Awl/StopWatch.h"
+#include "Awl/Random.h"
+
+#include "Awl/Testing/UnitTest.h"
+
+#include "Helpers/BenchmarkHelpers.h"
+
+#include <deque>
+#include <string>
+#include <cctype>
+
+using namespace awl::testing;
+
+namespace
+{
+    struct Handler
+    {
+        size_t index;
+    };
+
+    awl::StaticLink<Handler> h1("Alpha", 0u);
+    awl::StaticLink<Handler> h2("beta", 1u);
+    awl::StaticLink<Handler> h3("GAMMA", 2u);
+    awl::StaticLink<Handler> h4("alpha2", 3u);
+
+    //Registers the links at first use, they are never removed from the chain.
+    struct Value
+    {
+        size_t index;
+    };
+
+    const std::deque<std::string>& RegisterNames(size_t count)
+    {
+        static std::deque<std::string> names;
+        static std::deque<awl::StaticLink<Value>> links;
+
+        while (names.size() < count)
+        {
+            const size_t index = names.size();
+
+            names.push_back(awl::aformat() << "Handler_" << index * 7919 % 100003 << "_" << index);
+
+            links.emplace_back(names.back().c_str(), index);
+        }
+
+        return names;
+    }
+}
+
+AWL_TEST(StaticMapFrozen)
+{
+    AWL_UNUSED_CONTEXT;
+
+    awl::StaticMap<Handler> map = awl::StaticMap<Handler>::fill();
+
+    AWL_ASSERT_EQUAL(static_cast<size_t>(4), map.size());
+    AWL_ASSERT_FALSE(map.frozen());
+
+    map.freeze();
+
+    AWL_ASSERT(map.frozen());
+
+    const awl::StaticMap<Handler>& frozen_map = awl::frozen_static_map<Handler>();
+
+    AWL_ASSERT(frozen_map.frozen());
+
+    for (const awl::StaticMap<Handler>* p_map : { static_cast<const awl::StaticMap<Handler>*>(&map), &frozen_map })
+    {
+        AWL_ASSERT_EQUAL(static_cast<size_t>(0), p_map->find("alpha")->value().index);
+        AWL_ASSERT_EQUAL(static_cast<size_t>(1), p_map->find("BETA")->value().index);
+        AWL_ASSERT_EQUAL(static_cast<size_t>(2), p_map->find(std::string("Gamma"))->value().index);
+        AWL_ASSERT_EQUAL(static_cast<size_t>(3), p_map->find("ALPHA2")->value().index);
+
+        AWL_ASSERT(p_map->find("alph") == nullptr);
+        AWL_ASSERT(p_map->find("delta") == nullptr);
+        AWL_ASSERT(p_map->find("") == nullptr);
+    }
+
+    //The filter works as before.
+    map = awl::StaticMap<Handler>::fill("alpha.*");
+
+    map.freeze();
+
+    AWL_ASSERT_EQUAL(static_cast<size_t>(2), map.size());
+    AWL_ASSERT(map.find("ALPHA") != nullptr);
+    AWL_ASSERT(map.find("alpha2") != nullptr);
+    AWL_ASSERT(map.find("beta") == nullptr);
+}
+
+AWL_TEST(StaticMapFrozenLarge)
+{
+    AWL_UNUSED_CONTEXT;
+
+    AWL_ATTRIBUTE(size_t, element_count, 1000);
+
+    const std::deque<std::string>& names = RegisterNames(element_count);
+
+    awl::StaticMap<Value> map = awl::StaticMap<Value>::fill();
+
+    map.freeze();
+
+    AWL_ASSERT(map.frozen());
+
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        std::string upper = names[i];
+
+        std::ranges::transform(upper, upper.begin(), [](char ch) { return static_cast<char>(std::toupper(ch)); });
+
+        const awl::StaticLink<Value>* p_link = map.find(upper);
+
+        AWL_ASSERT(p_link != nullptr);
+        AWL_ASSERT_EQUAL(i, p_link->value().index);
+
+        AWL_ASSERT(map.find(names[i] + "_") == nullptr);
+    }
+}
+
+namespace
+{
+    template <class Func>
+    void MeasureFind(const TestContext& context, const awl::Char* name, const std::vector<std::string>& keys, Func&& find)
+    {
+        AWL_ATTRIBUTE(size_t, iteration_count, 100);
+
+        awl::StopWatch w;
+
+        size_t found_count = 0;
+
+        for (size_t i = 0; i < iteration_count; ++i)
+        {
+            for (const std::string& key : keys)
+            {
+                if (find(key.c_str()) != nullptr)
+                {
+                    ++found_count;
+                }
+            }
+        }
+
+        AWL_ASSERT_EQUAL(keys.size() * iteration_count, found_count);
+
+        context.logger.debug(awl::format() << name << _T(": "));
+
+        helpers::ReportCount(context, w, keys.size() * iteration_count);
+    }
+}
+
+AWL_BENCHMARK(StaticMapFind)
+{
+    AWL_ATTRIBUTE(size_t, element_count, 1000);
+
+    const std::deque<std::string>& names = RegisterNames(element_count);
+
+    std::vector<std::string> keys(names.begin(), names.end());
+
+    std::ranges::shuffle(keys, awl::random());
+
+    awl::StaticMap<Value> sorted_map = awl::StaticMap<Value>::fill();
+
+    awl::StaticMap<Value> frozen_map = awl::StaticMap<Value>::fill();
+
+    {
+        awl::StopWatch w;
+
+        frozen_map.freeze();
+
+        context.logger.debug(awl::format() << _T("freeze: ") << w.GetElapsedCast<std::chrono::microseconds>().count() << _T(" us"));
+    }
+
+    MeasureFind(context, _T("static_chain"), keys, [](const char* name)
+    {
+        return awl::static_chain<Value>().find(name);
+    });
+
+    MeasureFind(context, _T("sorted StaticMap"), keys, [&sorted_map](const char* name)
+    {
+        return sorted_map.find(name);
+    });
+
+    MeasureFind(context, _T("frozen StaticMap"), keys, [&frozen_map](const char* name)
+    {
+        return frozen_map.find(name);
+    });
+}
@@ -4,6 +4,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "Awl/Io/VectorStream.h"
+#include "Awl/Io/FieldMap.h"
 #include "Awl/Testing/UnitTest.h"
 #include "Awl/StopWatch.h"
 #include "Awl/StringFormat.h"
@@ -15,6 +16,7 @@
 
 #include "Tests/Helpers/BenchmarkHelpers.h"
 #include "Tests/Helpers/FormattingHelpers.h"
+#include "Tests/Helpers/NonBorrowingInputStream.h"
 #include "Tests/VtsTestCommon.h"
 
 using namespace awl::testing;
@@ -224,3 +226,542 @@ AWL_TEST(VtsDeletedType)
     AWL_ASSERT(e2.b == e1.b);
     AWL_ASSERT(e2.c == 1);
 }
+
+namespace
+{
+    template <class T>
+    void TestMeasureV(const T& val)
+    {
+        std::vector<uint8_t> v;
+
+        {
+            awl::io::VectorOutputStream out(v);
+
+            awl::io::WriteV(out, val);
+        }
+
+        AWL_ASSERT_EQUAL(v.size(), awl::io::MeasureV(val));
+    }
+}
+
+AWL_TEST(VtsMeasureV)
+{
+    AWL_UNUSED_CONTEXT;
+
+    TestMeasureV(E1{ "abc", { 1, 2, 3 } });
+    TestMeasureV(E2{ { 1, 2, 3 }, 1 });
+    TestMeasureV(v1::b_expected);
+}
+
+AWL_TEST(VtsReadPlanDeleteNotAllowed)
+{
+    AWL_UNUSED_CONTEXT;
+
+    using namespace awl::testing::vts_common;
+
+    std::vector<uint8_t> v;
+
+    {
+        awl::io::VectorOutputStream out(v);
+
+        WriteDataV1<OldVectorWriter>(out, 2, true);
+    }
+
+    awl::io::VectorInputStream in(v);
+
+    NewVectorReader ctx;
+    ctx.ReadOldPrototypes(in);
+
+    ctx.allowDelete = false;
+
+    //v2::A does not have the field 'a'.
+    try
+    {
+        vts_data::v2::A a2;
+        ctx.ReadV(in, a2);
+
+        AWL_FAILM("FieldNotFoundException is not thrown.");
+    }
+    catch (const awl::io::FieldNotFoundException&)
+    {
+    }
+}
+
+namespace
+{
+    struct Point
+    {
+        double x;
+        double y;
+        int64_t t;
+        int32_t a;
+        int32_t b;
+
+        AWL_REFLECT(x, y, t, a, b)
+    };
+
+    AWL_MEMBERWISE_EQUATABLE(Point)
+
+    //The same fields listed in the order that differs from their declaration.
+    struct ShuffledPoint
+    {
+        double x;
+        double y;
+        int64_t t;
+        int32_t a;
+        int32_t b;
+
+        AWL_REFLECT(y, x, t, b, a)
+    };
+
+    AWL_MEMBERWISE_EQUATABLE(ShuffledPoint)
+
+    //The prototype differs from Point.
+    struct PointV2
+    {
+        int32_t a;
+        int32_t b;
+        double x;
+        double y;
+        int64_t t;
+
+        AWL_REFLECT(a, b, x, y, t)
+    };
+
+    template <class P>
+    struct PointSet
+    {
+        awl::testing::helpers::Vector<P> points;
+
+        AWL_REFLECT(points)
+    };
+
+    static_assert(awl::io::packed_tuplizable<Point>);
+    static_assert(awl::io::packed_tuplizable<ShuffledPoint>);
+    static_assert(!awl::io::packed_tuplizable<v1::A>);
+
+    template <class P>
+    PointSet<P> MakePointSet(size_t count)
+    {
+        PointSet<P> set;
+
+        set.points.reserve(count);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            P p;
+
+            p.x = static_cast<double>(i) / 3;
+            p.y = static_cast<double>(i) * 3;
+            p.t = static_cast<int64_t>(i) << 20;
+            p.a = static_cast<int32_t>(i);
+            p.b = -static_cast<int32_t>(i);
+
+            set.points.push_back(p);
+        }
+
+        return set;
+    }
+
+    template <class P>
+    std::vector<uint8_t> WritePointSet(const PointSet<P>& set)
+    {
+        using V = awl::mp::variant_from_structs<PointSet<P>>;
+
+        std::vector<uint8_t> v;
+
+        awl::io::VectorOutputStream out(v);
+
+        awl::io::Writer<V, awl::io::VectorOutputStream> ctx;
+
+        ctx.WriteNewPrototypes(out);
+
+        ctx.WriteV(out, set);
+
+        return v;
+    }
+
+    template <class P, class IStream>
+    PointSet<P> ReadPointSet(IStream& in)
+    {
+        using V = awl::mp::variant_from_structs<PointSet<P>>;
+
+        awl::io::Reader<V, IStream> ctx;
+
+        ctx.ReadOldPrototypes(in);
+
+        PointSet<P> set;
+
+        ctx.ReadV(in, set);
+
+        AWL_ASSERT(in.End());
+
+        return set;
+    }
+}
+
+namespace
+{
+    //Packed, but not reflectable, so it is written without the structure indices.
+    struct TuplizablePoint
+    {
+        int32_t x;
+        int32_t y;
+
+        AWL_TUPLIZABLE(x, y)
+    };
+
+    AWL_MEMBERWISE_EQUATABLE(TuplizablePoint)
+
+    static_assert(awl::io::packed_tuplizable<TuplizablePoint>);
+
+    struct TuplizablePointSet
+    {
+        std::vector<TuplizablePoint> points;
+        int32_t n;
+
+        AWL_REFLECT(points, n)
+    };
+
+    AWL_MEMBERWISE_EQUATABLE(TuplizablePointSet)
+}
+
+namespace awl::mp
+{
+    //A non-reflectable structure needs its own type name.
+    template <>
+    struct type_descriptor<TuplizablePoint>
+    {
+        using inner_tuple = std::tuple<int32_t>;
+
+        static constexpr std::string name()
+        {
+            return std::string("point<int32_t>");
+        }
+    };
+}
+
+AWL_TEST(VtsPackedTuplizableStructs)
+{
+    AWL_UNUSED_CONTEXT;
+
+    using V = std::variant<TuplizablePointSet, std::vector<TuplizablePoint>, int32_t>;
+
+    TuplizablePointSet sample;
+
+    for (int32_t i = 0; i < 100; ++i)
+    {
+        sample.points.push_back({ i, -i });
+    }
+
+    sample.n = 5;
+
+    std::vector<uint8_t> v;
+
+    {
+        awl::io::VectorOutputStream out(v);
+
+        awl::io::Writer<V, awl::io::VectorOutputStream> ctx;
+
+        ctx.WriteNewPrototypes(out);
+
+        ctx.WriteV(out, sample);
+    }
+
+    awl::io::VectorInputStream in(v);
+
+    awl::io::Reader<V, awl::io::VectorInputStream> ctx;
+
+    ctx.ReadOldPrototypes(in);
+
+    TuplizablePointSet result;
+
+    ctx.ReadV(in, result);
+
+    AWL_ASSERT(result == sample);
+    AWL_ASSERT(in.End());
+}
+
+AWL_TEST(VtsPackedStructs)
+{
+    AWL_ATTRIBUTE(size_t, element_count, 1000);
+
+    AWL_ASSERT(awl::io::HasPackedLayout<Point>());
+    AWL_ASSERT(!awl::io::HasPackedLayout<ShuffledPoint>());
+
+    const PointSet<Point> sample = MakePointSet<Point>(element_count);
+
+    const std::vector<uint8_t> v = WritePointSet(sample);
+
+    {
+        awl::io::VectorInputStream in(v);
+
+        AWL_ASSERT(ReadPointSet<Point>(in).points == sample.points);
+    }
+
+    {
+        NonBorrowingInputStream in(v);
+
+        AWL_ASSERT(ReadPointSet<Point>(in).points == sample.points);
+    }
+
+    //The same data written field by field.
+    {
+        const PointSet<ShuffledPoint> shuffled = MakePointSet<ShuffledPoint>(element_count);
+
+        const std::vector<uint8_t> shuffled_v = WritePointSet(shuffled);
+
+        AWL_ASSERT_EQUAL(v.size(), shuffled_v.size());
+
+        awl::io::VectorInputStream in(shuffled_v);
+
+        AWL_ASSERT(ReadPointSet<ShuffledPoint>(in).points == shuffled.points);
+    }
+
+    //The prototypes are not equal, so the fields are read by the plan.
+    {
+        awl::io::VectorInputStream in(v);
+
+        const PointSet<PointV2> set = ReadPointSet<PointV2>(in);
+
+        AWL_ASSERT_EQUAL(sample.points.size(), set.points.size());
+
+        for (size_t i = 0; i < set.points.size(); ++i)
+        {
+            const Point& expected = sample.points[i];
+            const PointV2& actual = set.points[i];
+
+            AWL_ASSERT(actual.a == expected.a && actual.b == expected.b && actual.x == expected.x && actual.y == expected.y && actual.t == expected.t);
+        }
+    }
+
+    //Without VTS the vector is a single block.
+    {
+        std::vector<uint8_t> plain;
+
+        {
+            awl::io::VectorOutputStream out(plain);
+
+            awl::io::Write(out, sample.points);
+        }
+
+        AWL_ASSERT_EQUAL(sizeof(size_t) + sample.points.size() * sizeof(Point), plain.size());
+
+        awl::io::VectorInputStream in(plain);
+
+        awl::testing::helpers::Vector<Point> points;
+
+        awl::io::Read(in, points);
+
+        AWL_ASSERT(points == sample.points);
+    }
+
+    {
+        const awl::testing::helpers::Vector<ShuffledPoint> shuffled = MakePointSet<ShuffledPoint>(element_count).points;
+
+        std::vector<uint8_t> plain;
+
+        {
+            awl::io::VectorOutputStream out(plain);
+
+            awl::io::Write(out, shuffled);
+        }
+
+        AWL_ASSERT_EQUAL(sizeof(size_t) + shuffled.size() * sizeof(ShuffledPoint), plain.size());
+
+        NonBorrowingInputStream in(plain);
+
+        awl::testing::helpers::Vector<ShuffledPoint> actual;
+
+        awl::io::Read(in, actual);
+
+        AWL_ASSERT(actual == shuffled);
+    }
+}
+
+//./AwlTest --filter VtsPackedStructsBenchmark.* --output all --element_count 10000000
+AWL_BENCHMARK(VtsPackedStructsBenchmark)
+{
+    AWL_ATTRIBUTE(size_t, element_count, 1000000);
+
+    auto test = [&context, element_count]<class P>(const awl::Char* name, const PointSet<P>& sample)
+    {
+        std::vector<uint8_t> v;
+
+        {
+            awl::StopWatch w;
+
+            v = WritePointSet(sample);
+
+            context.logger.debug(awl::format() << name << _T(" write: "));
+
+            helpers::ReportCountAndSpeed(context, w, element_count, v.size());
+        }
+
+        {
+            awl::io::VectorInputStream in(v);
+
+            awl::StopWatch w;
+
+            const PointSet<P> set = ReadPointSet<P>(in);
+
+            context.logger.debug(awl::format() << name << _T(" read: "));
+
+            helpers::ReportCountAndSpeed(context, w, element_count, v.size());
+
+            AWL_ASSERT(set.points == sample.points);
+        }
+    };
+
+    test(_T("Field by field"), MakePointSet<ShuffledPoint>(element_count));
+    test(_T("Packed"), MakePointSet<Point>(element_count));
+}
+
+AWL_TEST(VtsDirectCopy)
+{
+    AWL_UNUSED_CONTEXT;
+
+    using namespace awl::testing::helpers;
+
+    //Vector<v1::A> and std::set<v1::C> are converted with the serialization, v1::A is converted directly.
+    v2::B expected = v2::b_expected;
+
+    awl::io::CopyVBuffered(v1::b_expected, expected);
+
+    {
+        v2::B b = v2::b_expected;
+
+        awl::io::CopyV(v1::b_expected, b);
+
+        AWL_ASSERT(b == expected);
+    }
+
+    {
+        v2::B b = v2::b_expected;
+
+        v1::B b1 = v1::b_expected;
+
+        awl::io::MoveV(std::move(b1), b);
+
+        AWL_ASSERT(b == expected);
+    }
+
+    {
+        v2::A a = v2::a_expected;
+
+        awl::io::CopyV(v1::a_expected, a);
+
+        AWL_ASSERT(a == v2::a_expected);
+    }
+
+    //The same type.
+    {
+        v1::B b;
+
+        awl::io::CopyV(v1::b_expected, b);
+
+        AWL_ASSERT(b == v1::b_expected);
+    }
+}
+
+namespace
+{
+    struct RenamedV1
+    {
+        int a;
+        std::string name;
+
+        AWL_REFLECT(a, name)
+    };
+
+    struct RenamedV2
+    {
+        int a;
+        std::string title;
+
+        AWL_REFLECT(a, title)
+    };
+}
+
+namespace awl::io
+{
+    template <>
+    class FieldMap<RenamedV2>
+    {
+    public:
+
+        static std::string_view GetNewName(std::string_view old_name)
+        {
+            using namespace std::literals;
+
+            if (old_name == "name"sv)
+            {
+                return "title"sv;
+            }
+
+            return old_name;
+        }
+    };
+}
+
+AWL_TEST(VtsDirectCopyRenamedField)
+{
+    AWL_UNUSED_CONTEXT;
+
+    const RenamedV1 v1 = { 5, "hello" };
+
+    {
+        RenamedV2 v2 = {};
+
+        awl::io::CopyVBuffered(v1, v2);
+
+        AWL_ASSERT(v2.a == 5 && v2.title == "hello");
+    }
+
+    {
+        RenamedV2 v2 = {};
+
+        awl::io::CopyV(v1, v2);
+
+        AWL_ASSERT(v2.a == 5 && v2.title == "hello");
+    }
+
+    {
+        RenamedV2 v2 = {};
+
+        RenamedV1 moved_v1 = v1;
+
+        awl::io::MoveV(std::move(moved_v1), v2);
+
+        AWL_ASSERT(v2.a == 5 && v2.title == "hello");
+    }
+}
+
+//./AwlTest --filter VtsCopyVBenchmark.* --output all --element_count 1000000
+AWL_BENCHMARK(VtsCopyVBenchmark)
+{
+    AWL_ATTRIBUTE(size_t, element_count, 100000);
+
+    using namespace awl::testing::helpers;
+
+    auto test = [&](const awl::Char* name, auto copy)
+    {
+        v2::A a;
+
+        awl::StopWatch w;
+
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            copy(v1::a_expected, a);
+        }
+
+        context.logger.debug(awl::format() << name << _T(": "));
+
+        helpers::ReportCount(context, w, element_count);
+
+        AWL_ASSERT(a.c == v1::a_expected.c);
+    };
+
+    test(_T("Buffered"), [](const v1::A& from, v2::A& to) { awl::io::CopyVBuffered(from, to); });
+    test(_T("Direct"), [](const v1::A& from, v2::A& to) { awl::io::CopyV(from, to); });
+}